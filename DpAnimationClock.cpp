@@ -0,0 +1,179 @@
+#include "DpAnimationClock.h"
+#include "DpThemeClient.h"
+#include <wx/window.h>
+#include <algorithm>
+#include <cmath>
+
+DpAnimationClock& DpAnimationClock::Instance() {
+    static DpAnimationClock instance;
+    return instance;
+}
+
+DpAnimationClock::DpAnimationClock() : DpWindowHooks(HookPaint), m_timer(this) {
+    Bind(wxEVT_TIMER, &DpAnimationClock::OnTimer, this);
+    Attach(DpThemeClient::Instance());
+}
+
+void DpAnimationClock::Attach(DpThemeClient& client) {
+    client.RegisterCallback([this, &client]() { SetPalette(client.GetResolvedPalette()); });
+}
+
+DpAnimationClock::~DpAnimationClock() {
+    m_timer.Stop();
+}
+
+void DpAnimationClock::Register(wxWindow* window, const wxRect& area) {
+    if (!window) return;
+
+    // Première zone de la fenêtre : un seul jeu de gestionnaires par fenêtre
+    auto last = std::find_if(m_entries.rbegin(), m_entries.rend(), [window](const Entry& e) {
+        return e.window == window;
+    });
+    if (last == m_entries.rend()) {
+        m_entries.push_back({window, area});
+        HookWindow(window);
+    } else {
+        m_entries.insert(last.base(), {window, area});
+    }
+
+    if (!m_hasPalette) {
+        SetPalette(DpThemeClient::Instance().GetResolvedPalette());
+    } else if (m_frames.empty()) {
+        BuildFrames();
+    }
+    Start();
+}
+
+void DpAnimationClock::Unregister(wxWindow* window, const wxRect& area) {
+    const bool all = area.IsEmpty();
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [window, all, &area](const Entry& e) {
+        return e.window == window && (all || e.area == area);
+    }), m_entries.end());
+
+    if (!HasWindow(window)) {
+        UnhookWindow(window);
+    }
+    if (m_entries.empty()) {
+        m_timer.Stop();
+    }
+}
+
+bool DpAnimationClock::HasWindow(wxWindow* window) const {
+    return std::any_of(m_entries.begin(), m_entries.end(), [window](const Entry& e) {
+        return e.window == window;
+    });
+}
+
+const wxColour& DpAnimationClock::GetFrameColor(DpColorRole role, DpAnimation animation) const {
+    const int r = static_cast<int>(role);
+    const int a = static_cast<int>(animation);
+    if (m_frames.empty() || r < 0 || r >= DpColorRoleCount || a < 0 || a >= DpAnimationCount) {
+        return m_palette.Get(role);
+    }
+    return m_frames[(static_cast<size_t>(a) * DpColorRoleCount + r) * m_frameCount + m_frame];
+}
+
+void DpAnimationClock::SetTiming(int frameMs, int periodMs) {
+    m_frameMs = std::max(1, frameMs);
+    m_frameCount = std::max(2, periodMs / m_frameMs);
+    m_frame = 0;
+    if (!m_frames.empty()) {
+        BuildFrames();
+    }
+
+    if (m_timer.IsRunning()) {
+        m_timer.Start(m_frameMs);
+    }
+}
+
+void DpAnimationClock::SetPalette(const DpResolvedPalette& palette) {
+    m_palette = palette;
+    m_hasPalette = true;
+
+    // Sans élément animé, les images ne sont calculées qu'au prochain Register
+    if (m_entries.empty()) {
+        m_frames.clear();
+    } else {
+        BuildFrames();
+    }
+}
+
+// Toutes les images de tous les rôles : le dessin n'a plus qu'une lecture à faire
+void DpAnimationClock::BuildFrames() {
+    if (!m_hasPalette) return;
+
+    const double pi = std::acos(-1.0);
+    m_frames.resize(static_cast<size_t>(DpAnimationCount) * DpColorRoleCount * m_frameCount);
+
+    auto mix = [](unsigned char from, unsigned char to, double t) {
+        return static_cast<unsigned char>(std::lround(from + (to - from) * t));
+    };
+
+    for (int a = 0; a < DpAnimationCount; ++a) {
+        for (int r = 0; r < DpColorRoleCount; ++r) {
+            const wxColour& on = m_palette.Get(static_cast<DpColorRole>(r));
+            const wxColour& off = m_palette.Get(static_cast<DpColorRole>(r), DpColorVariant::Blend25);
+            wxColour* frames = &m_frames[(static_cast<size_t>(a) * DpColorRoleCount + r) * m_frameCount];
+
+            for (int f = 0; f < m_frameCount; ++f) {
+                double t;
+                if (static_cast<DpAnimation>(a) == DpAnimation::Pulse) {
+                    t = 0.5 - 0.5 * std::cos(2.0 * pi * f / m_frameCount);  // 0 -> 1 -> 0
+                } else {
+                    t = (f * 2 < m_frameCount) ? 0.0 : 1.0;
+                }
+                frames[f] = wxColour(mix(on.Red(), off.Red(), t),
+                                     mix(on.Green(), off.Green(), t),
+                                     mix(on.Blue(), off.Blue(), t),
+                                     mix(on.Alpha(), off.Alpha(), t));
+            }
+        }
+    }
+}
+
+void DpAnimationClock::Start() {
+    if (!m_entries.empty() && !m_timer.IsRunning()) {
+        m_timer.Start(m_frameMs);
+    }
+}
+
+// Un tick : image suivante, puis une invalidation par fenêtre visible
+void DpAnimationClock::OnTimer(wxTimerEvent& WXUNUSED(event)) {
+    m_frame = (m_frame + 1) % m_frameCount;
+
+    bool anyVisible = false;
+    size_t i = 0;
+    while (i < m_entries.size()) {
+        wxWindow* window = m_entries[i].window;
+        const bool visible = !window->IsBeingDeleted() && window->IsShownOnScreen();
+
+        // Union des zones de la fenêtre (entrées contiguës)
+        bool whole = false;
+        wxRect dirty;
+        for (; i < m_entries.size() && m_entries[i].window == window; ++i) {
+            if (m_entries[i].area.IsEmpty()) {
+                whole = true;
+            } else {
+                dirty = dirty.IsEmpty() ? m_entries[i].area : dirty.Union(m_entries[i].area);
+            }
+        }
+
+        if (!visible) continue;
+        anyVisible = true;
+        if (whole) {
+            window->Refresh(false);
+        } else {
+            window->RefreshRect(dirty, false);
+        }
+    }
+
+    // Rien d'animé à l'écran : on repart au prochain repeint d'une fenêtre animée
+    if (!anyVisible) {
+        m_timer.Stop();
+    }
+}
+
+// Une fenêtre animée redevenue visible relance le timer arrêté faute de zone visible
+void DpAnimationClock::OnWindowPaint(wxWindow* WXUNUSED(window)) {
+    Start();
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "DpColorVariants.h"
+#include "DpWindowHooks.h"
+#include <wx/gdicmn.h>
+#include <wx/timer.h>
+#include <vector>
+
+// Forward declaration
+class wxWindow;
+class DpThemeClient;
+
+/**
+ * @brief Animations des indicateurs (alarmes, avertissements)
+ */
+enum class DpAnimation {
+    Pulse,  // Va-et-vient adouci entre la couleur et sa variante Blend25
+    Blink   // Alternance franche couleur / Blend25
+};
+
+constexpr int DpAnimationCount = static_cast<int>(DpAnimation::Blink) + 1;
+
+/**
+ * @brief Horloge d'animation partagée par tous les éléments animés
+ *
+ * Un seul wxTimer fait avancer l'image courante ; les couleurs de chaque image
+ * sont précalculées depuis la palette active (recalculées à chaque changement de
+ * thème). À chaque tick, les zones enregistrées sont invalidées en une passe,
+ * une seule fois par fenêtre. Le timer s'arrête quand aucun élément n'est
+ * visible et repart dès qu'une fenêtre animée est repeinte.
+ *
+ * Dans le gestionnaire wxEVT_PAINT, l'élément lit GetFrameColor().
+ */
+class DpAnimationClock : public DpWindowHooks {
+public:
+    static DpAnimationClock& Instance();
+
+    // Enregistre une zone animée (toute la fenêtre si area est vide) ;
+    // désenregistrée automatiquement à la destruction de la fenêtre
+    void Register(wxWindow* window, const wxRect& area = wxRect());
+
+    // Retire une zone, ou toutes celles de la fenêtre si area est vide
+    void Unregister(wxWindow* window, const wxRect& area = wxRect());
+
+    // Couleur de l'image courante pour un rôle
+    const wxColour& GetFrameColor(DpColorRole role, DpAnimation animation = DpAnimation::Pulse) const;
+    int GetFrame() const { return m_frame; }
+
+    // Cadence et période d'un cycle, en millisecondes
+    void SetTiming(int frameMs, int periodMs);
+
+    // Recalcule les images depuis la palette active
+    void SetPalette(const DpResolvedPalette& palette);
+    
+    // Suit la palette du client à chaque changement de thème ; le client du plugin
+    // (DpThemeClient::Instance) est suivi dès la création de l'horloge
+    void Attach(DpThemeClient& client);
+
+    bool IsRunning() const { return m_timer.IsRunning(); }
+
+private:
+    DpAnimationClock();
+    ~DpAnimationClock() override;
+
+    // Non copiable
+    DpAnimationClock(const DpAnimationClock&) = delete;
+    DpAnimationClock& operator=(const DpAnimationClock&) = delete;
+
+    struct Entry {
+        wxWindow* window;
+        wxRect area;
+    };
+
+    wxTimer m_timer;
+    std::vector<Entry> m_entries;  // Regroupées par fenêtre
+    int m_frameMs = 33;
+    int m_frameCount = 30;         // Images par cycle
+    int m_frame = 0;
+    bool m_hasPalette = false;
+
+    // [DpAnimation][DpColorRole][image]
+    std::vector<wxColour> m_frames;
+    DpResolvedPalette m_palette;
+
+    void BuildFrames();
+    void Start();
+    bool HasWindow(wxWindow* window) const;
+
+    void OnTimer(wxTimerEvent& event);
+    bool IsHooked(wxWindow* window) const override { return HasWindow(window); }
+    void OnWindowDestroyed(wxWindow* window) override { Unregister(window); }
+    void OnWindowPaint(wxWindow* window) override;
+};
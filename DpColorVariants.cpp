@@ -0,0 +1,171 @@
+#include "DpColorVariants.h"
+#include "DpRgb565.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int kRoles = DpColorRoleCount;
+    using Channel = std::array<float, kRoles>;
+
+    // Décalages en luminance OKLab (0..1) et facteurs de chroma
+    constexpr float kHoverDelta = 0.06f;
+    constexpr float kPressedDelta = 0.12f;
+    constexpr float kFocusDelta = 0.03f;
+    constexpr float kFocusChroma = 1.25f;
+    constexpr float kDisabledChroma = 0.35f;
+    constexpr float kDisabledMix = 0.5f;  // Part de la luminance du fond
+
+    const std::array<float, 256>& SrgbToLinear() {
+        static const std::array<float, 256> table = [] {
+            std::array<float, 256> t{};
+            for (int i = 0; i < 256; ++i) {
+                const float c = i / 255.0f;
+                t[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    unsigned char LinearToSrgb(float c) {
+        c = std::clamp(c, 0.0f, 1.0f);
+        const float s = c <= 0.0031308f ? 12.92f * c : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+        return static_cast<unsigned char>(std::lround(s * 255.0f));
+    }
+
+    /**
+     * @brief Couleurs de tous les rôles, une composante par tableau
+     */
+    struct Lab {
+        Channel L{}, a{}, b{};
+    };
+
+    // sRGB -> OKLab (Björn Ottosson)
+    Lab ToOklab(const Channel& r, const Channel& g, const Channel& b) {
+        Channel l, m, s;
+        for (int i = 0; i < kRoles; ++i) {
+            l[i] = std::cbrt(0.4122214708f * r[i] + 0.5363325363f * g[i] + 0.0514459929f * b[i]);
+            m[i] = std::cbrt(0.2119034982f * r[i] + 0.6806995451f * g[i] + 0.1073969566f * b[i]);
+            s[i] = std::cbrt(0.0883024619f * r[i] + 0.2817188376f * g[i] + 0.6299787005f * b[i]);
+        }
+
+        Lab lab;
+        for (int i = 0; i < kRoles; ++i) {
+            lab.L[i] = 0.2104542553f * l[i] + 0.7936177850f * m[i] - 0.0040720468f * s[i];
+            lab.a[i] = 1.9779984951f * l[i] - 2.4285922050f * m[i] + 0.4505937099f * s[i];
+            lab.b[i] = 0.0259040371f * l[i] + 0.7827717662f * m[i] - 0.8086757660f * s[i];
+        }
+        return lab;
+    }
+
+    // OKLab -> sRGB, écrit dans la colonne d'une variante
+    void StoreOklab(const Lab& lab, const Channel& alpha, DpColorVariant variant, DpResolvedPalette& out) {
+        Channel r, g, b;
+        for (int i = 0; i < kRoles; ++i) {
+            const float l = lab.L[i] + 0.3963377774f * lab.a[i] + 0.2158037573f * lab.b[i];
+            const float m = lab.L[i] - 0.1055613458f * lab.a[i] - 0.0638541728f * lab.b[i];
+            const float s = lab.L[i] - 0.0894841775f * lab.a[i] - 1.2914855480f * lab.b[i];
+            const float l3 = l * l * l, m3 = m * m * m, s3 = s * s * s;
+            r[i] = 4.0767416621f * l3 - 3.3077115913f * m3 + 0.2309699292f * s3;
+            g[i] = -1.2684380046f * l3 + 2.6097574011f * m3 - 0.3413193965f * s3;
+            b[i] = -0.0041960863f * l3 - 0.7034186147f * m3 + 1.7076147010f * s3;
+        }
+
+        for (int i = 0; i < kRoles; ++i) {
+            out.colors[i][static_cast<int>(variant)] =
+                wxColour(LinearToSrgb(r[i]), LinearToSrgb(g[i]), LinearToSrgb(b[i]),
+                         static_cast<unsigned char>(alpha[i]));
+        }
+    }
+
+    // Variante : luminance décalée de delta (vers le contraste), chroma multipliée
+    void StoreShifted(const Lab& base, const Channel& alpha, float direction, float delta, float chroma,
+                      DpColorVariant variant, DpResolvedPalette& out) {
+        Lab lab;
+        for (int i = 0; i < kRoles; ++i) {
+            lab.L[i] = std::clamp(base.L[i] + direction * delta, 0.0f, 1.0f);
+            lab.a[i] = base.a[i] * chroma;
+            lab.b[i] = base.b[i] * chroma;
+        }
+        StoreOklab(lab, alpha, variant, out);
+    }
+}
+
+void DpResolvedPalette::Build(const DpPalette& palette) {
+    const std::array<float, 256>& toLinear = SrgbToLinear();
+
+    // Lecture de la palette une seule fois, en structure de tableaux
+    std::array<wxColour, kRoles> base;
+    Channel r, g, b, alpha;
+    for (int i = 0; i < kRoles; ++i) {
+        base[i] = palette[static_cast<DpColorRole>(i)];
+        if (!base[i].IsOk()) {
+            base[i] = wxColour(0, 0, 0);  // Rôle absent du thème : noir, comme un wxColour() dessiné
+        }
+        r[i] = toLinear[base[i].Red()];
+        g[i] = toLinear[base[i].Green()];
+        b[i] = toLinear[base[i].Blue()];
+        alpha[i] = base[i].Alpha();
+    }
+
+    const Lab lab = ToOklab(r, g, b);
+
+    // Thème sombre : les états actifs éclaircissent ; thème clair : ils assombrissent
+    const int background = static_cast<int>(DpColorRole::Background_1);
+    const float bgL = lab.L[background];
+    const float direction = bgL < 0.5f ? 1.0f : -1.0f;
+
+    for (int i = 0; i < kRoles; ++i) {
+        colors[i][static_cast<int>(DpColorVariant::Base)] = base[i];
+    }
+    StoreShifted(lab, alpha, direction, kHoverDelta, 1.0f, DpColorVariant::Hover, *this);
+    StoreShifted(lab, alpha, direction, kPressedDelta, 1.0f, DpColorVariant::Pressed, *this);
+    StoreShifted(lab, alpha, direction, kFocusDelta, kFocusChroma, DpColorVariant::Focus, *this);
+
+    Lab disabled;
+    for (int i = 0; i < kRoles; ++i) {
+        disabled.L[i] = lab.L[i] + (bgL - lab.L[i]) * kDisabledMix;
+        disabled.a[i] = lab.a[i] * kDisabledChroma;
+        disabled.b[i] = lab.b[i] * kDisabledChroma;
+    }
+    StoreOklab(disabled, alpha, DpColorVariant::Disabled, *this);
+
+    // Transparences : alpha seul, ou composé (en sRGB, comme un DC) sur Background_1
+    const wxColour& bg = base[background];
+    const struct { DpColorVariant alpha; DpColorVariant blend; float level; } levels[] = {
+        {DpColorVariant::Alpha75, DpColorVariant::Blend75, 0.75f},
+        {DpColorVariant::Alpha50, DpColorVariant::Blend50, 0.50f},
+        {DpColorVariant::Alpha25, DpColorVariant::Blend25, 0.25f},
+    };
+    for (const auto& level : levels) {
+        for (int i = 0; i < kRoles; ++i) {
+            const wxColour& c = base[i];
+            auto mix = [&level](int fg, int back) {
+                return static_cast<unsigned char>(std::lround(back + (fg - back) * level.level));
+            };
+            colors[i][static_cast<int>(level.alpha)] =
+                wxColour(c.Red(), c.Green(), c.Blue(), static_cast<unsigned char>(std::lround(c.Alpha() * level.level)));
+            colors[i][static_cast<int>(level.blend)] =
+                wxColour(mix(c.Red(), bg.Red()), mix(c.Green(), bg.Green()), mix(c.Blue(), bg.Blue()));
+        }
+    }
+}
+
+void DpResolvedPalette::QuantizeRgb565() {
+    for (auto& variants : colors) {
+        for (wxColour& colour : variants) {
+            const wxColour snapped = DpFromRgb565(DpToRgb565(colour));
+            colour = wxColour(snapped.Red(), snapped.Green(), snapped.Blue(), colour.Alpha());
+        }
+    }
+}
+
+const wxColour& DpResolvedPalette::Get(DpColorRole role, DpColorVariant variant) const {
+    const int r = static_cast<int>(role);
+    const int v = static_cast<int>(variant);
+    if (r < 0 || r >= kRoles || v < 0 || v >= DpColorVariantCount) {
+        static const wxColour black(0, 0, 0);
+        return black;
+    }
+    return colors[r][v];
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "DpThemes.h"
+#include <array>
+#include <wx/colour.h>
+
+// Variantes dérivées de chaque rôle, précalculées au changement de thème
+enum class DpColorVariant {
+    Base,      // Couleur du thème
+    Hover,     // Survol : luminance perçue décalée vers le contraste
+    Pressed,   // Appui : décalage double du survol
+    Focus,     // Focus : chroma renforcée
+    Disabled,  // Désaturée et rapprochée du fond
+    Alpha75,   // Même couleur, canal alpha à 75 % (wxGraphicsContext)
+    Alpha50,
+    Alpha25,
+    Blend75,   // Opaque : 75 % de la couleur sur Background_1 (wxDC sans alpha)
+    Blend50,
+    Blend25
+};
+
+// Nombre de variantes (à maintenir avec la dernière valeur)
+constexpr int DpColorVariantCount = static_cast<int>(DpColorVariant::Blend25) + 1;
+
+/**
+ * @brief Palette d'un mode résolue en tableau : couleurs et variantes indexées par rôle
+ *
+ * Construite une fois par changement de thème ; le code de dessin fait une
+ * simple lecture au lieu d'éclaircir ou de mélanger à chaque paint.
+ */
+struct DpResolvedPalette {
+    std::array<std::array<wxColour, DpColorVariantCount>, DpColorRoleCount> colors;
+
+    // Calcul en OKLab, tous les rôles à la fois (un tableau par composante)
+    void Build(const DpPalette& palette);
+
+    const wxColour& Get(DpColorRole role, DpColorVariant variant = DpColorVariant::Base) const;
+
+    // Ramène toutes les couleurs sur la grille RGB565 (sortie 16 bits)
+    void QuantizeRgb565();
+};
@@ -0,0 +1,476 @@
+#include "DpFontCatalog.h"
+#include <wx/log.h>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    uint16_t ReadU16(const uint8_t* p) {
+        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+    }
+
+    uint32_t ReadU32(const uint8_t* p) {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+             | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+    }
+
+    bool IsPrivateUse(char32_t codepoint) {
+        return codepoint >= 0xE000 && codepoint <= 0xF8FF;
+    }
+
+    // Points de code de compatibilité (FA4 "-o", anciens noms FA5) que les fontes FA6 Free
+    // associent en plus du point de code canonique au même glyphe ("square" : U+F096 en
+    // plus de U+F0C8). Relevés dans les OTF livrés ; triés pour la recherche dichotomique.
+    constexpr char32_t kLegacyAliases[] = {
+        0xe0cf, 0xe4ee, 0xf003, 0xf006, 0xf014, 0xf016, 0xf01a, 0xf01b, 0xf01d, 0xf040,
+        0xf045, 0xf046, 0xf05c, 0xf05d, 0xf087, 0xf088, 0xf08a, 0xf096, 0xf097, 0xf0a2,
+        0xf0e4, 0xf0e5, 0xf0e6, 0xf0f5, 0xf0f6, 0xf0f7, 0xf108, 0xf10c, 0xf112, 0xf114,
+        0xf115, 0xf11d, 0xf123, 0xf147, 0xf18e, 0xf190, 0xf196, 0xf1b1, 0xf1d9, 0xf1db,
+        0xf1f7, 0xf24a, 0xf250, 0xf278, 0xf27b, 0xf283, 0xf28c, 0xf28e, 0xf295, 0xf29c,
+        0xf2b7, 0xf2ba, 0xf2bc, 0xf2be, 0xf2c0, 0xf2c3, 0xf2d4, 0xf332, 0xf381, 0xf382,
+        0xf3fd, 0xf425, 0xf47d, 0xf4a1, 0xf4e6, 0xf541, 0xf80a, 0xf80b, 0xf80c, 0xf8e5,
+    };
+
+    bool IsLegacyAlias(char32_t codepoint) {
+        return std::binary_search(std::begin(kLegacyAliases), std::end(kLegacyAliases), codepoint);
+    }
+
+    // Rang de préférence d'un point de code (plus petit = préféré) : zone privée canonique,
+    // puis alias de compatibilité de la zone privée, puis hors zone privée (ASCII, emoji)
+    int CodepointRank(char32_t codepoint) {
+        if (!IsPrivateUse(codepoint)) return 2;
+        return IsLegacyAlias(codepoint) ? 1 : 0;
+    }
+
+    // Zone mémoire bornée (toutes les lectures de la fonte passent par Has)
+    struct Span {
+        const uint8_t* data;
+        size_t size;
+        bool Has(size_t offset, size_t length) const {
+            return offset <= size && length <= size - offset;
+        }
+    };
+
+    // Chaînes standard CFF utilisées par les fontes Font Awesome (SID 0..95, plage ASCII)
+    constexpr std::string_view kCffStandardStrings[] = {
+        ".notdef", "space", "exclam", "quotedbl", "numbersign", "dollar", "percent",
+        "ampersand", "quoteright", "parenleft", "parenright", "asterisk", "plus",
+        "comma", "hyphen", "period", "slash", "zero", "one", "two", "three", "four",
+        "five", "six", "seven", "eight", "nine", "colon", "semicolon", "less",
+        "equal", "greater", "question", "at",
+        "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M",
+        "N", "O", "P", "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z",
+        "bracketleft", "backslash", "bracketright", "asciicircum", "underscore",
+        "quoteleft",
+        "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m",
+        "n", "o", "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z",
+        "braceleft", "bar", "braceright", "asciitilde"
+    };
+    constexpr size_t kCffStandardStringCount = 391;
+
+    // INDEX CFF (compte, taille des offsets, base des données)
+    struct CffIndex {
+        size_t count = 0;
+        size_t offSize = 0;
+        size_t offsets = 0;   // Position du tableau d'offsets
+        size_t dataBase = 0;  // Position de l'octet précédant les données (offsets 1-based)
+        size_t end = 0;
+    };
+
+    size_t ReadOffset(const Span& cff, const CffIndex& index, size_t i) {
+        const uint8_t* p = cff.data + index.offsets + i * index.offSize;
+        size_t value = 0;
+        for (size_t b = 0; b < index.offSize; ++b) {
+            value = (value << 8) | p[b];
+        }
+        return value;
+    }
+
+    bool ParseIndex(const Span& cff, size_t pos, CffIndex& out) {
+        if (!cff.Has(pos, 2)) return false;
+        out = CffIndex();
+        out.count = ReadU16(cff.data + pos);
+        if (out.count == 0) {
+            out.end = pos + 2;
+            return true;
+        }
+        if (!cff.Has(pos + 2, 1)) return false;
+        out.offSize = cff.data[pos + 2];
+        if (out.offSize < 1 || out.offSize > 4) return false;
+        out.offsets = pos + 3;
+        if (!cff.Has(out.offsets, (out.count + 1) * out.offSize)) return false;
+        out.dataBase = out.offsets + (out.count + 1) * out.offSize - 1;
+        out.end = out.dataBase + ReadOffset(cff, out, out.count);
+        return out.end <= cff.size;
+    }
+
+    bool IndexItem(const Span& cff, const CffIndex& index, size_t i, size_t& start, size_t& length) {
+        if (i >= index.count) return false;
+        const size_t first = ReadOffset(cff, index, i);
+        const size_t last = ReadOffset(cff, index, i + 1);
+        if (first < 1 || last < first || index.dataBase + last > cff.size) return false;
+        start = index.dataBase + first;
+        length = last - first;
+        return true;
+    }
+
+    // Top DICT : seuls charset (15), CharStrings (17) et ROS (12 30) nous intéressent
+    void ParseTopDict(const Span& cff, size_t start, size_t length,
+                      long& charset, long& charStrings, bool& isCid) {
+        long operand = 0;
+        size_t i = start;
+        const size_t end = start + length;
+        while (i < end) {
+            const uint8_t b0 = cff.data[i];
+            if (b0 <= 21) {
+                int op = b0;
+                if (b0 == 12 && i + 1 < end) {
+                    op = 1200 + cff.data[++i];
+                }
+                if (op == 15) charset = operand;
+                if (op == 17) charStrings = operand;
+                if (op == 1230) isCid = true;
+                ++i;
+            } else if (b0 == 28 && i + 2 < end) {
+                operand = static_cast<int16_t>(ReadU16(cff.data + i + 1));
+                i += 3;
+            } else if (b0 == 29 && i + 4 < end) {
+                operand = static_cast<int32_t>(ReadU32(cff.data + i + 1));
+                i += 5;
+            } else if (b0 == 30) {
+                // Réel : quartets jusqu'au terminateur 0xf
+                for (++i; i < end; ++i) {
+                    if ((cff.data[i] & 0x0f) == 0x0f || (cff.data[i] >> 4) == 0x0f) break;
+                }
+                ++i;
+            } else if (b0 >= 32 && b0 <= 246) {
+                operand = b0 - 139;
+                ++i;
+            } else if (b0 >= 247 && b0 <= 250 && i + 1 < end) {
+                operand = (b0 - 247) * 256 + cff.data[i + 1] + 108;
+                i += 2;
+            } else if (b0 >= 251 && b0 <= 254 && i + 1 < end) {
+                operand = -(b0 - 251) * 256 - cff.data[i + 1] - 108;
+                i += 2;
+            } else {
+                ++i;
+            }
+        }
+    }
+}
+
+uint64_t DpFontCatalog::Fingerprint(const uint8_t* data, size_t size) {
+    const Span font{data, size};
+    if (!font.Has(0, 12)) {
+        return 0;
+    }
+    
+    const size_t directorySize = 12 + static_cast<size_t>(ReadU16(font.data + 4)) * 16;
+    if (!font.Has(0, directorySize)) {
+        return 0;
+    }
+    
+    uint64_t hash = DpHashBytes(reinterpret_cast<const uint8_t*>(&size), sizeof(size));
+    hash = DpHashBytes(font.data, directorySize, hash);
+    
+    // head.checkSumAdjustment (octets 8..11) : somme de tout le fichier, absente du répertoire
+    for (size_t record = 12; record < directorySize; record += 16) {
+        const size_t offset = ReadU32(font.data + record + 8);
+        if (std::equal(font.data + record, font.data + record + 4, "head") && font.Has(offset, 12)) {
+            hash = DpHashBytes(font.data + offset + 8, 4, hash);
+        }
+    }
+    return hash;
+}
+
+bool DpFontCatalog::Open(const wxString& path) {
+    m_index = std::make_unique<NameIndex>();
+    m_cmapSubtable = 0;
+    m_cmapFormat = 0;
+    m_cffOffset = 0;
+    m_cffSize = 0;
+
+    if (!m_file.Open(path)) {
+        return false;
+    }
+
+    const Span font{m_file.Data(), m_file.Size()};
+    if (!font.Has(0, 12)) {
+        m_file.Close();
+        return false;
+    }
+
+    // Répertoire des tables
+    size_t cmapOffset = 0;
+    size_t cmapSize = 0;
+    const uint16_t numTables = ReadU16(font.data + 4);
+    for (uint16_t i = 0; i < numTables; ++i) {
+        const size_t record = 12 + static_cast<size_t>(i) * 16;
+        if (!font.Has(record, 16)) break;
+        const uint8_t* tag = font.data + record;
+        const size_t offset = ReadU32(font.data + record + 8);
+        const size_t length = ReadU32(font.data + record + 12);
+        if (!font.Has(offset, length)) continue;
+
+        if (std::equal(tag, tag + 4, "cmap")) {
+            cmapOffset = offset;
+            cmapSize = length;
+        } else if (std::equal(tag, tag + 4, "CFF ")) {
+            m_cffOffset = offset;
+            m_cffSize = length;
+        }
+    }
+
+    // Sous-table Unicode : format 12 (plein Unicode) de préférence, sinon format 4 (BMP)
+    int bestRank = 0;
+    const Span cmap{font.data + cmapOffset, cmapSize};
+    const uint16_t subtables = cmap.Has(0, 4) ? ReadU16(cmap.data + 2) : 0;
+    for (uint16_t i = 0; i < subtables; ++i) {
+        const size_t record = 4 + static_cast<size_t>(i) * 8;
+        if (!cmap.Has(record, 8)) break;
+        const uint16_t platform = ReadU16(cmap.data + record);
+        const uint16_t encoding = ReadU16(cmap.data + record + 2);
+        const size_t offset = ReadU32(cmap.data + record + 4);
+        if (!cmap.Has(offset, 16)) continue;
+
+        const uint16_t format = ReadU16(cmap.data + offset);
+        const bool unicode = platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10));
+        int rank = 0;
+        if (unicode && format == 12) rank = 2;
+        else if (unicode && format == 4) rank = 1;
+
+        if (rank > bestRank) {
+            bestRank = rank;
+            m_cmapSubtable = cmapOffset + offset;
+            m_cmapFormat = format;
+        }
+    }
+
+    if (m_cmapFormat == 0) {
+        wxLogDebug("No Unicode cmap in font: %s", path);
+        m_file.Close();
+        return false;
+    }
+    return true;
+}
+
+uint32_t DpFontCatalog::LookupGlyphId(char32_t codepoint) const {
+    const Span font{m_file.Data(), m_file.Size()};
+    const size_t table = m_cmapSubtable;
+
+    if (m_cmapFormat == 4) {
+        if (codepoint > 0xFFFF || !font.Has(table, 14)) return 0;
+        const size_t segCountX2 = ReadU16(font.data + table + 6);
+        const size_t ends = table + 14;
+        const size_t starts = ends + segCountX2 + 2;
+        const size_t deltas = starts + segCountX2;
+        const size_t rangeOffsets = deltas + segCountX2;
+        if (!font.Has(ends, segCountX2 * 4 + 2)) return 0;
+
+        // Premier segment dont la fin est >= codepoint
+        size_t lo = 0;
+        size_t hi = segCountX2 / 2;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (ReadU16(font.data + ends + mid * 2) < codepoint) lo = mid + 1; else hi = mid;
+        }
+        if (lo == segCountX2 / 2) return 0;
+
+        const uint16_t start = ReadU16(font.data + starts + lo * 2);
+        if (codepoint < start) return 0;
+        const uint16_t delta = ReadU16(font.data + deltas + lo * 2);
+        const uint16_t rangeOffset = ReadU16(font.data + rangeOffsets + lo * 2);
+        if (rangeOffset == 0) {
+            return static_cast<uint16_t>(codepoint + delta);
+        }
+        const size_t address = rangeOffsets + lo * 2 + rangeOffset + (codepoint - start) * 2;
+        if (!font.Has(address, 2)) return 0;
+        const uint16_t glyph = ReadU16(font.data + address);
+        return glyph ? static_cast<uint16_t>(glyph + delta) : 0;
+    }
+
+    // Format 12 : groupes triés {début, fin, premier glyphe}
+    if (!font.Has(table, 16)) return 0;
+    const size_t groups = ReadU32(font.data + table + 12);
+    if (!font.Has(table + 16, groups * 12)) return 0;
+    size_t lo = 0;
+    size_t hi = groups;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        const uint8_t* group = font.data + table + 16 + mid * 12;
+        if (ReadU32(group + 4) < codepoint) lo = mid + 1; else hi = mid;
+    }
+    if (lo == groups) return 0;
+    const uint8_t* group = font.data + table + 16 + lo * 12;
+    const uint32_t first = ReadU32(group);
+    return codepoint >= first ? ReadU32(group + 8) + (codepoint - first) : 0;
+}
+
+void DpFontCatalog::ForEachMapping(const std::function<void(char32_t, uint32_t)>& visit) const {
+    const Span font{m_file.Data(), m_file.Size()};
+    const size_t table = m_cmapSubtable;
+
+    if (m_cmapFormat == 4) {
+        if (!font.Has(table, 14)) return;
+        const size_t segCount = ReadU16(font.data + table + 6) / 2;
+        const size_t ends = table + 14;
+        if (!font.Has(ends, segCount * 8 + 2)) return;
+        const size_t starts = ends + segCount * 2 + 2;
+        for (size_t s = 0; s < segCount; ++s) {
+            const uint32_t start = ReadU16(font.data + starts + s * 2);
+            const uint32_t end = ReadU16(font.data + ends + s * 2);
+            for (uint32_t cp = start; cp <= end && cp < 0xFFFF; ++cp) {
+                if (const uint32_t glyph = LookupGlyphId(cp)) visit(cp, glyph);
+            }
+        }
+        return;
+    }
+
+    if (!font.Has(table, 16)) return;
+    const size_t groups = ReadU32(font.data + table + 12);
+    if (!font.Has(table + 16, groups * 12)) return;
+    for (size_t g = 0; g < groups; ++g) {
+        const uint8_t* group = font.data + table + 16 + g * 12;
+        const uint32_t start = ReadU32(group);
+        const uint32_t end = std::min<uint32_t>(ReadU32(group + 4), 0x10FFFF);
+        const uint32_t glyph = ReadU32(group + 8);
+        for (uint32_t cp = start; cp <= end && cp >= start; ++cp) {
+            visit(cp, glyph + (cp - start));
+        }
+    }
+}
+
+// Noms des glyphes par identifiant, lus dans le charset CFF
+bool DpFontCatalog::ReadGlyphNames(std::vector<std::string_view>& names) const {
+    if (m_cffSize == 0) {
+        return false;
+    }
+
+    const Span cff{m_file.Data() + m_cffOffset, m_cffSize};
+    if (!cff.Has(0, 4)) return false;
+
+    CffIndex nameIndex;
+    CffIndex topIndex;
+    CffIndex stringIndex;
+    if (!ParseIndex(cff, cff.data[2], nameIndex)
+        || !ParseIndex(cff, nameIndex.end, topIndex)
+        || !ParseIndex(cff, topIndex.end, stringIndex)) {
+        return false;
+    }
+
+    size_t topStart = 0;
+    size_t topLength = 0;
+    if (!IndexItem(cff, topIndex, 0, topStart, topLength)) return false;
+
+    long charset = 0;
+    long charStrings = 0;
+    bool isCid = false;
+    ParseTopDict(cff, topStart, topLength, charset, charStrings, isCid);
+
+    // Les fontes CID n'ont pas de noms ; charsets prédéfinis Expert non gérés
+    CffIndex glyphs;
+    if (isCid || charStrings <= 0 || charset == 1 || charset == 2
+        || !ParseIndex(cff, static_cast<size_t>(charStrings), glyphs)) {
+        return false;
+    }
+
+    auto nameOf = [&](size_t sid) -> std::string_view {
+        if (sid < std::size(kCffStandardStrings)) return kCffStandardStrings[sid];
+        if (sid < kCffStandardStringCount) return {};
+        size_t start = 0;
+        size_t length = 0;
+        if (!IndexItem(cff, stringIndex, sid - kCffStandardStringCount, start, length)) return {};
+        return std::string_view(reinterpret_cast<const char*>(cff.data + start), length);
+    };
+
+    names.assign(glyphs.count, std::string_view());
+    if (charset == 0) {
+        // ISOAdobe : SID == identifiant de glyphe
+        for (size_t gid = 0; gid < glyphs.count; ++gid) names[gid] = nameOf(gid);
+        return true;
+    }
+
+    size_t pos = static_cast<size_t>(charset);
+    if (!cff.Has(pos, 1)) return false;
+    const uint8_t format = cff.data[pos++];
+    size_t gid = 1;
+    while (gid < glyphs.count) {
+        if (format == 0) {
+            if (!cff.Has(pos, 2)) return false;
+            names[gid++] = nameOf(ReadU16(cff.data + pos));
+            pos += 2;
+        } else if (format == 1 || format == 2) {
+            const size_t recordSize = format == 1 ? 3 : 4;
+            if (!cff.Has(pos, recordSize)) return false;
+            const size_t first = ReadU16(cff.data + pos);
+            const size_t left = format == 1 ? cff.data[pos + 2] : ReadU16(cff.data + pos + 2);
+            pos += recordSize;
+            for (size_t k = 0; k <= left && gid < glyphs.count; ++k) {
+                names[gid++] = nameOf(first + k);
+            }
+        } else {
+            return false;
+        }
+    }
+    names[0] = nameOf(0);
+    return true;
+}
+
+// Index des noms construit une fois, même si plusieurs threads le demandent ensemble
+const std::vector<DpFontCatalog::NameEntry>& DpFontCatalog::GetNames() const {
+    static const std::vector<NameEntry> empty;
+    if (!m_index) {
+        return empty;
+    }
+    std::call_once(m_index->built, [this]() { BuildNameIndex(m_index->entries); });
+    return m_index->entries;
+}
+
+void DpFontCatalog::BuildNameIndex(std::vector<NameEntry>& names) const {
+    names.clear();
+    if (!IsOpen()) return;
+
+    std::vector<std::string_view> glyphNames;
+    if (!ReadGlyphNames(glyphNames)) {
+        wxLogDebug("Font has no readable glyph names");
+        return;
+    }
+
+    // Point de code préféré par glyphe : le canonique FA6, les alias en dernier recours
+    std::vector<char32_t> codepoints(glyphNames.size(), 0);
+    ForEachMapping([&](char32_t cp, uint32_t glyph) {
+        if (glyph == 0 || glyph >= codepoints.size()) return;
+        char32_t& current = codepoints[glyph];
+        if (current == 0
+            || CodepointRank(cp) < CodepointRank(current)
+            || (CodepointRank(cp) == CodepointRank(current) && cp < current)) {
+            current = cp;
+        }
+    });
+
+    names.reserve(glyphNames.size());
+    for (size_t gid = 1; gid < glyphNames.size(); ++gid) {
+        if (codepoints[gid] != 0 && !glyphNames[gid].empty()) {
+            names.push_back({glyphNames[gid], codepoints[gid]});
+        }
+    }
+    std::sort(names.begin(), names.end(), [](const NameEntry& a, const NameEntry& b) {
+        return a.name < b.name;
+    });
+}
+
+bool DpFontCatalog::HasGlyph(char32_t codepoint) const {
+    return IsOpen() && LookupGlyphId(codepoint) != 0;
+}
+
+char32_t DpFontCatalog::FindCodepoint(std::string_view glyphName) const {
+    const std::vector<NameEntry>& names = GetNames();
+    auto it = std::lower_bound(names.begin(), names.end(), glyphName,
+                               [](const NameEntry& entry, std::string_view name) {
+                                   return entry.name < name;
+                               });
+    return (it != names.end() && it->name == glyphName) ? it->codepoint : 0;
+}
+
+size_t DpFontCatalog::GetNamedGlyphCount() const {
+    return GetNames().size();
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DpMappedFile.h"
+#include <wx/string.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Catalogue des glyphes d'une fonte OpenType (OTF/CFF), lu dans la projection mémoire
+ *
+ * Open() ne fait que projeter le fichier et repérer les tables. La table cmap est
+ * interrogée en place (HasGlyph). L'index des noms, issu du charset CFF (le post
+ * des OTF Font Awesome est en version 3, sans noms), n'est construit qu'au
+ * premier FindCodepoint() : vecteur trié de vues sur les chaînes de la projection.
+ * Une fois ouvert, le catalogue se lit depuis tout thread (index construit sous call_once).
+ */
+class DpFontCatalog {
+public:
+    bool Open(const wxString& path);
+    bool IsOpen() const { return m_file.IsOpen(); }
+
+    // Octets du fichier projeté, valides tant que le catalogue est ouvert
+    const uint8_t* Data() const { return m_file.Data(); }
+    size_t Size() const { return m_file.Size(); }
+
+    // Le point de code a-t-il un glyphe (hors .notdef) ?
+    bool HasGlyph(char32_t codepoint) const;
+
+    // Point de code d'un glyphe nommé ("xmark-large"), 0 si absent.
+    // Le point de code canonique FA6 est préféré ; les alias de compatibilité FA4/FA5,
+    // puis les alias ASCII, ne servent que si le glyphe n'en a pas d'autre.
+    char32_t FindCodepoint(std::string_view glyphName) const;
+
+    // Nombre de glyphes nommés et accessibles par un point de code
+    size_t GetNamedGlyphCount() const;
+
+    // Empreinte d'un fichier OTF sans le parcourir : taille, répertoire des tables (sommes
+    // de contrôle, positions, longueurs) et head.checkSumAdjustment. 0 si l'en-tête est invalide.
+    static uint64_t Fingerprint(const uint8_t* data, size_t size);
+
+private:
+    struct NameEntry {
+        std::string_view name;
+        char32_t codepoint;
+    };
+
+    DpMappedFile m_file;
+    size_t m_cmapSubtable = 0;  // Offset absolu de la sous-table Unicode retenue
+    uint16_t m_cmapFormat = 0;  // 4 ou 12
+    size_t m_cffOffset = 0;
+    size_t m_cffSize = 0;
+
+    // Index des noms, recréé par Open et rempli une seule fois, au premier besoin
+    struct NameIndex {
+        std::once_flag built;
+        std::vector<NameEntry> entries;
+    };
+    std::unique_ptr<NameIndex> m_index;
+
+    uint32_t LookupGlyphId(char32_t codepoint) const;
+    void ForEachMapping(const std::function<void(char32_t, uint32_t)>& visit) const;
+    bool ReadGlyphNames(std::vector<std::string_view>& names) const;
+    const std::vector<NameEntry>& GetNames() const;
+    void BuildNameIndex(std::vector<NameEntry>& names) const;
+};
\ No newline at end of file
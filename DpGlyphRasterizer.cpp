@@ -0,0 +1,213 @@
+#include "DpGlyphRasterizer.h"
+#include <wx/log.h>
+#include <algorithm>
+#include <mutex>
+
+// FreeType est optionnel : le build qui le lie définit DP_HAVE_FREETYPE=1 et ajoute le
+// répertoire freetype2 aux chemins d'en-têtes (pkg-config freetype2, ou find_package(Freetype)
+// en CMake). Sans lui, RenderIconAlpha/RenderIconRGBA échouent ; le dessin par wxFont reste.
+#ifndef DP_HAVE_FREETYPE
+#define DP_HAVE_FREETYPE 0
+#endif
+
+#if DP_HAVE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace {
+    std::atomic<uint64_t> g_nextRasterizerId{1};
+
+    uint64_t MakeKey(DpIconFace face, char32_t codepoint, int pixelSize) {
+        return static_cast<uint64_t>(face)
+             | (static_cast<uint64_t>(codepoint) << 8)
+             | (static_cast<uint64_t>(pixelSize & 0xffff) << 32);
+    }
+
+    // splitmix64 : répartit les clés voisines (même face, tailles proches)
+    size_t HashKey(uint64_t key) {
+        key += 0x9e3779b97f4a7c15ULL;
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<size_t>(key ^ (key >> 31));
+    }
+
+#if DP_HAVE_FREETYPE
+    /**
+     * @brief Bibliothèque et faces FreeType du thread courant (FreeType n'est pas
+     * thread-safe par FT_Library : chaque thread a les siennes)
+     */
+    struct ThreadFaces {
+        uint64_t owner = 0;
+        FT_Library library = nullptr;
+        std::array<FT_Face, DpIconFaceCount> faces{};
+
+        ~ThreadFaces() { Reset(); }
+
+        void Reset() {
+            for (FT_Face& face : faces) {
+                if (face) {
+                    FT_Done_Face(face);
+                    face = nullptr;
+                }
+            }
+            if (library) {
+                FT_Done_FreeType(library);
+                library = nullptr;
+            }
+            owner = 0;
+        }
+    };
+
+    thread_local ThreadFaces t_faces;
+#endif
+}
+
+DpGlyphRasterizer::DpGlyphRasterizer()
+    : m_id(g_nextRasterizerId++),
+      m_slots(new std::atomic<const Entry*>[kSlotCount]) {
+    for (size_t i = 0; i < kSlotCount; ++i) {
+        m_slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+DpGlyphRasterizer::~DpGlyphRasterizer() {
+    for (size_t i = 0; i < kSlotCount; ++i) {
+        delete m_slots[i].load(std::memory_order_acquire);
+    }
+}
+
+bool DpGlyphRasterizer::IsAvailable() {
+    return DP_HAVE_FREETYPE != 0;
+}
+
+const DpGlyphBitmap* DpGlyphRasterizer::GetGlyph(DpIconFace face, const DpGlyphFontData& font, char32_t codepoint,
+                                                int pixelSize, DpGlyphBitmap* overflow) {
+    if (pixelSize <= 0 || pixelSize > 0xffff) {
+        return nullptr;
+    }
+
+    const uint64_t key = MakeKey(face, codepoint, pixelSize);
+    const size_t home = HashKey(key);
+
+    // Lecture sans verrou : une case publiée n'est jamais modifiée
+    for (size_t probe = 0; probe < kMaxProbe; ++probe) {
+        const Entry* entry = m_slots[(home + probe) & (kSlotCount - 1)].load(std::memory_order_acquire);
+        if (!entry) {
+            break;
+        }
+        if (entry->key == key) {
+            return &entry->bitmap;
+        }
+    }
+
+    auto fresh = std::make_unique<Entry>();
+    fresh->key = key;
+    if (!Render(face, font, codepoint, pixelSize, fresh->bitmap)) {
+        return nullptr;
+    }
+
+    // Publication : le premier thread à occuper la case gagne, les autres réutilisent son entrée
+    for (size_t probe = 0; probe < kMaxProbe; ++probe) {
+        std::atomic<const Entry*>& slot = m_slots[(home + probe) & (kSlotCount - 1)];
+        const Entry* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, fresh.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return &fresh.release()->bitmap;
+        }
+        if (expected->key == key) {
+            return &expected->bitmap;
+        }
+    }
+
+    // Table pleine sur ce voisinage : le rendu est rendu à l'appelant, sans le refaire
+    if (!overflow) {
+        return nullptr;
+    }
+    *overflow = std::move(fresh->bitmap);
+    return overflow;
+}
+
+bool DpGlyphRasterizer::Rasterize(DpIconFace face, const DpGlyphFontData& font, char32_t codepoint, int pixelSize,
+                                  DpGlyphBitmap& out) {
+    const DpGlyphBitmap* glyph = GetGlyph(face, font, codepoint, pixelSize, &out);
+    if (!glyph) {
+        return false;
+    }
+    if (glyph != &out) {
+        out = *glyph;
+    }
+    return true;
+}
+
+// Rendu FreeType avec les faces du thread courant
+bool DpGlyphRasterizer::Render(DpIconFace face, const DpGlyphFontData& font, char32_t codepoint, int pixelSize,
+                               DpGlyphBitmap& out) {
+#if DP_HAVE_FREETYPE
+    if (!font.data) {
+        return false;
+    }
+
+    ThreadFaces& local = t_faces;
+    if (local.owner != m_id) {
+        local.Reset();
+        if (FT_Init_FreeType(&local.library) != 0) {
+            local.library = nullptr;
+            return false;
+        }
+        local.owner = m_id;
+    }
+
+    FT_Face& ftFace = local.faces[static_cast<int>(face)];
+    if (!ftFace && FT_New_Memory_Face(local.library, font.data, static_cast<FT_Long>(font.size), 0, &ftFace) != 0) {
+        ftFace = nullptr;
+        wxLogDebug("FreeType unable to open icon face %d", static_cast<int>(face));
+        return false;
+    }
+
+    if (FT_Set_Pixel_Sizes(ftFace, 0, static_cast<FT_UInt>(pixelSize)) != 0
+        || FT_Load_Char(ftFace, codepoint, FT_LOAD_RENDER) != 0) {
+        return false;
+    }
+
+    // Boîte : avance x hauteur de ligne, ligne de base à l'ascendante (métriques 26.6)
+    const FT_GlyphSlot slot = ftFace->glyph;
+    const FT_Size_Metrics& metrics = ftFace->size->metrics;
+    const int ascender = static_cast<int>((metrics.ascender + 63) >> 6);
+    out.width = std::max(1, static_cast<int>((slot->advance.x + 63) >> 6));
+    out.height = std::max(1, static_cast<int>((metrics.height + 63) >> 6));
+    out.alpha.assign(static_cast<size_t>(out.width) * out.height, 0);
+
+    const FT_Bitmap& bitmap = slot->bitmap;
+    if (bitmap.pixel_mode != FT_PIXEL_MODE_GRAY) {
+        return bitmap.rows == 0;  // Glyphe vide (espace)
+    }
+
+    const int left = slot->bitmap_left;
+    const int top = ascender - slot->bitmap_top;
+    for (int y = 0; y < static_cast<int>(bitmap.rows); ++y) {
+        const int dy = top + y;
+        if (dy < 0 || dy >= out.height) continue;
+
+        const unsigned char* src = bitmap.buffer + static_cast<ptrdiff_t>(y) * bitmap.pitch;
+        uint8_t* dst = out.alpha.data() + static_cast<size_t>(dy) * out.width;
+        for (int x = 0; x < static_cast<int>(bitmap.width); ++x) {
+            const int dx = left + x;
+            if (dx >= 0 && dx < out.width) {
+                dst[dx] = src[x];
+            }
+        }
+    }
+    return true;
+#else
+    (void)face;
+    (void)font;
+    (void)codepoint;
+    (void)pixelSize;
+    (void)out;
+    static std::once_flag warned;
+    std::call_once(warned, []() {
+        wxLogWarning("DpGlyphRasterizer: built without DP_HAVE_FREETYPE, off-thread icon rendering is unavailable");
+    });
+    return false;
+#endif
+}
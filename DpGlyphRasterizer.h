@@ -0,0 +1,81 @@
+#pragma once
+
+#include "DpIconAtlas.h"
+#include "DpIconTypes.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Glyphe rendu en couleur, RGBA 8 bits non prémultiplié (comme wxImage + alpha)
+ */
+struct DpGlyphRGBA {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> rgba;
+};
+
+/**
+ * @brief Fichier OTF d'une face, projeté en mémoire par son propriétaire (DpIconManager)
+ */
+struct DpGlyphFontData {
+    const uint8_t* data = nullptr;  // nullptr : face absente
+    size_t size = 0;
+};
+
+/**
+ * @brief Rendu de glyphes Font Awesome utilisable depuis n'importe quel thread
+ *
+ * N'utilise ni wxFont ni DC : chaque thread crée sa propre FT_Face FreeType sur
+ * l'OTF déjà projeté par DpIconManager, partagé en lecture seule, passé à chaque
+ * appel : pour une face, toujours la même projection, qui doit survivre au
+ * rasteriseur. Le choix du glyphe (face et point de code) revient à l'appelant,
+ * d'après la table résolue par DpIconManager. Les glyphes rendus
+ * sont publiés dans une table à adressage ouvert de pointeurs atomiques : la lecture
+ * se fait sans verrou, et les entrées restent immuables jusqu'à la destruction
+ * du rasteriseur.
+ *
+ * La boîte rendue (avance x hauteur de ligne, ligne de base à l'ascendante)
+ * suit celle de DpIconManager::RasterizeIcon, mais l'anticrénelage de FreeType
+ * peut différer de celui de la plateforme au pixel près.
+ */
+class DpGlyphRasterizer {
+public:
+    DpGlyphRasterizer();
+    ~DpGlyphRasterizer();
+
+    // Non copiable
+    DpGlyphRasterizer(const DpGlyphRasterizer&) = delete;
+    DpGlyphRasterizer& operator=(const DpGlyphRasterizer&) = delete;
+
+    // FreeType lié à la compilation (DP_HAVE_FREETYPE=1) ; sinon tout rendu échoue
+    static bool IsAvailable();
+
+    // Glyphe en cache (rendu au premier appel) ; valide jusqu'à la destruction.
+    // Si la table est pleine, le glyphe rendu est déplacé dans *overflow, dont l'adresse
+    // est retournée (nullptr sans overflow). nullptr si le rendu échoue.
+    const DpGlyphBitmap* GetGlyph(DpIconFace face, const DpGlyphFontData& font, char32_t codepoint,
+                                  int pixelSize, DpGlyphBitmap* overflow = nullptr);
+
+    // Copie du glyphe (un seul rendu, même si la table est pleine)
+    bool Rasterize(DpIconFace face, const DpGlyphFontData& font, char32_t codepoint, int pixelSize,
+                   DpGlyphBitmap& out);
+
+private:
+    struct Entry {
+        uint64_t key;
+        DpGlyphBitmap bitmap;
+    };
+
+    static constexpr size_t kSlotCount = 4096;  // Puissance de 2
+    static constexpr size_t kMaxProbe = 32;
+
+    const uint64_t m_id;  // Identifie le rasteriseur auprès des faces FreeType de chaque thread
+    std::unique_ptr<std::atomic<const Entry*>[]> m_slots;
+
+    bool Render(DpIconFace face, const DpGlyphFontData& font, char32_t codepoint, int pixelSize,
+                DpGlyphBitmap& out);
+};
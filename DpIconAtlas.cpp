@@ -0,0 +1,236 @@
+#include "DpIconAtlas.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+    constexpr int kMaxAtlasSize = 8192;
+    constexpr int kMaxMipLevels = 8;
+
+    int NextPowerOfTwo(int v) {
+        int p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    // Réduction 2x2 (box filter) d'un niveau vers le suivant.
+    // Les données sont en alpha prémultiplié, la moyenne directe est donc correcte.
+    void Downsample(const DpAtlasMipLevel& src, int bpp, DpAtlasMipLevel& dst) {
+        dst.width = std::max(1, src.width / 2);
+        dst.height = std::max(1, src.height / 2);
+        dst.pixels.assign(static_cast<size_t>(dst.width) * dst.height * bpp, 0);
+
+        for (int y = 0; y < dst.height; ++y) {
+            const int sy0 = std::min(y * 2, src.height - 1);
+            const int sy1 = std::min(y * 2 + 1, src.height - 1);
+            const uint8_t* row0 = &src.pixels[static_cast<size_t>(sy0) * src.width * bpp];
+            const uint8_t* row1 = &src.pixels[static_cast<size_t>(sy1) * src.width * bpp];
+            uint8_t* out = &dst.pixels[static_cast<size_t>(y) * dst.width * bpp];
+
+            for (int x = 0; x < dst.width; ++x) {
+                const int sx0 = std::min(x * 2, src.width - 1) * bpp;
+                const int sx1 = std::min(x * 2 + 1, src.width - 1) * bpp;
+                for (int c = 0; c < bpp; ++c) {
+                    const int sum = row0[sx0 + c] + row0[sx1 + c] + row1[sx0 + c] + row1[sx1 + c];
+                    out[x * bpp + c] = static_cast<uint8_t>((sum + 2) >> 2);
+                }
+            }
+        }
+    }
+}
+
+// ========== DpSkylinePacker ==========
+
+DpSkylinePacker::DpSkylinePacker(int width, int height)
+    : m_width(width), m_height(height) {
+    m_skyline.push_back({0, 0, width});
+}
+
+int DpSkylinePacker::Fit(size_t index, int width, int height) const {
+    const int x = m_skyline[index].x;
+    if (x + width > m_width) {
+        return -1;
+    }
+
+    int widthLeft = width;
+    int y = m_skyline[index].y;
+    size_t i = index;
+    while (widthLeft > 0) {
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) {
+            return -1;
+        }
+        widthLeft -= m_skyline[i].width;
+        ++i;
+    }
+    return y;
+}
+
+void DpSkylinePacker::AddLevel(size_t index, const DpAtlasRect& rect) {
+    m_skyline.insert(m_skyline.begin() + index, {rect.x, rect.y + rect.height, rect.width});
+
+    // Rogne ou supprime les segments recouverts par le nouveau
+    for (size_t i = index + 1; i < m_skyline.size(); ++i) {
+        const Segment& prev = m_skyline[i - 1];
+        const int prevEnd = prev.x + prev.width;
+        if (m_skyline[i].x >= prevEnd) {
+            break;
+        }
+        const int shrink = prevEnd - m_skyline[i].x;
+        m_skyline[i].x += shrink;
+        m_skyline[i].width -= shrink;
+        if (m_skyline[i].width > 0) {
+            break;
+        }
+        m_skyline.erase(m_skyline.begin() + i);
+        --i;
+    }
+
+    // Fusionne les segments adjacents de même hauteur
+    for (size_t i = 0; i + 1 < m_skyline.size();) {
+        if (m_skyline[i].y == m_skyline[i + 1].y) {
+            m_skyline[i].width += m_skyline[i + 1].width;
+            m_skyline.erase(m_skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
+
+bool DpSkylinePacker::Insert(int width, int height, DpAtlasRect& out) {
+    int bestTop = m_height + 1;
+    int bestSegmentWidth = m_width + 1;
+    size_t bestIndex = m_skyline.size();
+
+    for (size_t i = 0; i < m_skyline.size(); ++i) {
+        const int y = Fit(i, width, height);
+        if (y < 0) continue;
+
+        // Bottom-left : le bord haut le plus bas, puis le segment le plus étroit
+        const int top = y + height;
+        if (top < bestTop || (top == bestTop && m_skyline[i].width < bestSegmentWidth)) {
+            bestTop = top;
+            bestSegmentWidth = m_skyline[i].width;
+            bestIndex = i;
+            out = {m_skyline[i].x, y, width, height};
+        }
+    }
+
+    if (bestIndex == m_skyline.size()) {
+        return false;
+    }
+
+    AddLevel(bestIndex, out);
+    return true;
+}
+
+// ========== DpIconAtlas ==========
+
+bool DpIconAtlas::Build(const std::vector<DpGlyphBitmap>& glyphs,
+                        DpAtlasFormat format,
+                        int maxMipLevels,
+                        DpIconAtlas& out) {
+    if (glyphs.size() != static_cast<size_t>(DpIconCount)) {
+        return false;
+    }
+
+    out = DpIconAtlas();
+    out.format = format;
+
+    // Les glyphes sont posés sur une grille alignée sur 2^(niveaux-1) et séparés
+    // d'au moins une cellule : chaque niveau de mip garde ainsi 1 pixel d'écart.
+    const int levelCount = std::clamp(maxMipLevels, 1, kMaxMipLevels);
+    const int align = 1 << (levelCount - 1);
+    const int offset = align / 2;
+
+    std::vector<int> cellW(glyphs.size());
+    std::vector<int> cellH(glyphs.size());
+    long long area = 0;
+    int widest = 1;
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const DpGlyphBitmap& g = glyphs[i];
+        if (g.alpha.size() != static_cast<size_t>(g.width) * g.height) {
+            return false;
+        }
+        cellW[i] = (g.width + align + align - 1) / align;
+        cellH[i] = (g.height + align + align - 1) / align;
+        area += static_cast<long long>(cellW[i]) * cellH[i];
+        widest = std::max(widest, cellW[i] * align);
+        out.glyphPixelSize = std::max(out.glyphPixelSize, std::max(g.width, g.height));
+    }
+
+    // Du plus haut au plus large : meilleur remplissage pour un skyline
+    std::vector<size_t> order(glyphs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return cellH[a] != cellH[b] ? cellH[a] > cellH[b] : cellW[a] > cellW[b];
+    });
+
+    // Taille de départ en puissance de 2, agrandie jusqu'à ce que tout rentre
+    int side = 1;
+    while (static_cast<long long>(side) * side < area * align * align) side <<= 1;
+    int width = std::max(NextPowerOfTwo(widest), side);
+    int height = side;
+
+    std::array<DpAtlasRect, DpIconCount> cells{};
+    for (;;) {
+        DpSkylinePacker packer(width / align, height / align);
+        bool packed = true;
+        for (size_t index : order) {
+            if (!packer.Insert(cellW[index], cellH[index], cells[index])) {
+                packed = false;
+                break;
+            }
+        }
+        if (packed) break;
+
+        if (width <= height) width <<= 1; else height <<= 1;
+        if (width > kMaxAtlasSize || height > kMaxAtlasSize) {
+            return false;
+        }
+    }
+
+    // Niveau 0
+    const int bpp = out.BytesPerPixel();
+    out.levels.resize(1);
+    DpAtlasMipLevel& base = out.levels[0];
+    base.width = width;
+    base.height = height;
+    base.pixels.assign(static_cast<size_t>(width) * height * bpp, 0);
+
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        const DpGlyphBitmap& g = glyphs[i];
+        DpAtlasRect& rect = out.rects[i];
+        rect = {cells[i].x * align + offset, cells[i].y * align + offset, g.width, g.height};
+
+        for (int y = 0; y < g.height; ++y) {
+            const uint8_t* src = &g.alpha[static_cast<size_t>(y) * g.width];
+            uint8_t* dst = &base.pixels[(static_cast<size_t>(rect.y + y) * width + rect.x) * bpp];
+            if (format == DpAtlasFormat::Alpha8) {
+                std::copy(src, src + g.width, dst);
+            } else {
+                // Blanc prémultiplié : RGB = A
+                for (int x = 0; x < g.width; ++x) {
+                    std::fill_n(dst + x * 4, 4, src[x]);
+                }
+            }
+        }
+
+        out.uvs[i] = {
+            static_cast<float>(rect.x) / width,
+            static_cast<float>(rect.y) / height,
+            static_cast<float>(rect.x + rect.width) / width,
+            static_cast<float>(rect.y + rect.height) / height
+        };
+    }
+
+    // Niveaux suivants
+    for (int level = 1; level < levelCount; ++level) {
+        const DpAtlasMipLevel& prev = out.levels.back();
+        if (prev.width == 1 && prev.height == 1) break;
+        DpAtlasMipLevel next;
+        Downsample(prev, bpp, next);
+        out.levels.push_back(std::move(next));
+    }
+
+    return true;
+}
\ No newline at end of file
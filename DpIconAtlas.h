@@ -0,0 +1,108 @@
+#pragma once
+
+#include "DpIconTypes.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Format des pixels de l'atlas
+ */
+enum class DpAtlasFormat {
+    RGBA8,  // RGBA 8 bits, alpha prémultiplié (glyphe blanc, teinté par la couleur du quad)
+    Alpha8  // Couverture seule, 1 octet par pixel (GL_ALPHA / GL_RED)
+};
+
+/**
+ * @brief Rectangle en pixels dans le niveau 0 de l'atlas
+ */
+struct DpAtlasRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+/**
+ * @brief Coordonnées de texture normalisées d'une icône
+ */
+struct DpAtlasUV {
+    float u0 = 0.f;
+    float v0 = 0.f;
+    float u1 = 0.f;
+    float v1 = 0.f;
+};
+
+/**
+ * @brief Niveau de mip de l'atlas (pixels contigus, sans padding de ligne)
+ */
+struct DpAtlasMipLevel {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+/**
+ * @brief Bitmap de couverture d'un glyphe (1 octet par pixel)
+ */
+struct DpGlyphBitmap {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> alpha;
+};
+
+/**
+ * @brief Atlas de toutes les icônes, prêt à être chargé une seule fois en texture GL
+ */
+struct DpIconAtlas {
+    DpAtlasFormat format = DpAtlasFormat::RGBA8;
+    int glyphPixelSize = 0;
+
+    // levels[0] = pleine résolution, chaque niveau suivant divise par 2
+    std::vector<DpAtlasMipLevel> levels;
+
+    // Table des rectangles et UV, indexée par DpIcon
+    std::array<DpAtlasRect, DpIconCount> rects{};
+    std::array<DpAtlasUV, DpIconCount> uvs{};
+
+    int BytesPerPixel() const { return format == DpAtlasFormat::RGBA8 ? 4 : 1; }
+    const DpAtlasRect& GetRect(DpIcon icon) const { return rects[static_cast<size_t>(icon)]; }
+    const DpAtlasUV& GetUV(DpIcon icon) const { return uvs[static_cast<size_t>(icon)]; }
+
+    // Construit l'atlas à partir des glyphes (un par DpIcon, dans l'ordre de l'énum).
+    // Indépendant de wxWidgets : utilisable sans affichage.
+    static bool Build(const std::vector<DpGlyphBitmap>& glyphs,
+                      DpAtlasFormat format,
+                      int maxMipLevels,
+                      DpIconAtlas& out);
+};
+
+/**
+ * @brief Packer "skyline" (bottom-left) pour rectangles dans une zone fixe
+ */
+class DpSkylinePacker {
+public:
+    DpSkylinePacker(int width, int height);
+
+    // Place un rectangle ; retourne false si la place manque
+    bool Insert(int width, int height, DpAtlasRect& out);
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+private:
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    int m_width;
+    int m_height;
+    std::vector<Segment> m_skyline;
+
+    // Retourne la hauteur de pose pour un rectangle démarrant au segment index, ou -1
+    int Fit(size_t index, int width, int height) const;
+    void AddLevel(size_t index, const DpAtlasRect& rect);
+};
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include "DpIconCache.h"
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/log.h>
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace {
+    constexpr char kMagic[4] = {'D', 'P', 'I', 'C'};
+    constexpr uint32_t kVersion = 3;  // 3 : masques de couverture seuls (plus de RGB par couleur)
+    constexpr uint32_t kByteOrder = 0x01020304;
+
+    struct DiskHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t count;
+    };
+
+    struct DiskEntry {
+        uint64_t fontHash;
+        uint64_t offset;      // Position des pixels depuis le début du fichier
+        uint32_t rgba;        // 0 pour un masque
+        uint16_t icon;
+        uint16_t pixelSize;
+        uint16_t dpiPercent;
+        uint16_t width;
+        uint16_t height;
+        uint8_t face;
+        uint8_t reserved;
+    };
+
+    static_assert(sizeof(DiskHeader) == 16, "DiskHeader layout");
+    static_assert(sizeof(DiskEntry) == 32, "DiskEntry layout");
+
+    DpIconCacheKey KeyOf(const DiskEntry& e) {
+        DpIconCacheKey key;
+        key.fontHash = e.fontHash;
+        key.rgba = e.rgba;
+        key.icon = e.icon;
+        key.pixelSize = e.pixelSize;
+        key.dpiPercent = e.dpiPercent;
+        key.face = e.face;
+        return key;
+    }
+
+    size_t PixelBytes(size_t width, size_t height) {
+        return width * height;  // Couverture seule
+    }
+
+    const DiskEntry* Entries(const DpMappedFile& file) {
+        return reinterpret_cast<const DiskEntry*>(file.Data() + sizeof(DiskHeader));
+    }
+}
+
+bool DpIconCacheKey::operator<(const DpIconCacheKey& other) const {
+    return std::tie(fontHash, face, icon, pixelSize, dpiPercent, rgba)
+         < std::tie(other.fontHash, other.face, other.icon, other.pixelSize, other.dpiPercent, other.rgba);
+}
+
+bool DpIconCacheKey::operator==(const DpIconCacheKey& other) const {
+    return std::tie(fontHash, face, icon, pixelSize, dpiPercent, rgba)
+        == std::tie(other.fontHash, other.face, other.icon, other.pixelSize, other.dpiPercent, other.rgba);
+}
+
+bool DpIconDiskCache::Open(const wxString& path) {
+    m_path = path;
+    m_count = 0;
+    m_file.Close();
+
+    if (!wxFileExists(path) || !m_file.Open(path)) {
+        return false;
+    }
+
+    // Validation de l'en-tête et des bornes avant toute lecture
+    const size_t size = m_file.Size();
+    if (size < sizeof(DiskHeader)) {
+        m_file.Close();
+        return false;
+    }
+
+    DiskHeader header;
+    std::memcpy(&header, m_file.Data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+        || header.version != kVersion
+        || header.byteOrder != kByteOrder
+        || sizeof(DiskHeader) + static_cast<size_t>(header.count) * sizeof(DiskEntry) > size) {
+        wxLogDebug("Discarding invalid icon cache: %s", path);
+        m_file.Close();
+        return false;
+    }
+
+    const DiskEntry* entries = Entries(m_file);
+    for (uint32_t i = 0; i < header.count; ++i) {
+        const DiskEntry& e = entries[i];
+        if (e.offset > size || PixelBytes(e.width, e.height) > size - e.offset) {
+            wxLogDebug("Discarding truncated icon cache: %s", path);
+            m_file.Close();
+            return false;
+        }
+        if (e.face >= DpIconFaceCount || e.icon >= DpIconCount) {
+            wxLogDebug("Discarding icon cache with unknown icons: %s", path);
+            m_file.Close();
+            return false;
+        }
+    }
+
+    m_count = header.count;
+    return true;
+}
+
+bool DpIconDiskCache::Lookup(const DpIconCacheKey& key, DpGlyphBitmap& out) const {
+    auto pending = m_pending.find(key);
+    if (pending != m_pending.end()) {
+        out = pending->second;
+        return true;
+    }
+
+    if (m_count > 0) {
+        const DiskEntry* begin = Entries(m_file);
+        const DiskEntry* end = begin + m_count;
+        const DiskEntry* it = std::lower_bound(begin, end, key, [](const DiskEntry& e, const DpIconCacheKey& k) {
+            return KeyOf(e) < k;
+        });
+        if (it == end || !(KeyOf(*it) == key)) {
+            return false;
+        }
+        const uint8_t* alpha = m_file.Data() + it->offset;
+        out.width = it->width;
+        out.height = it->height;
+        out.alpha.assign(alpha, alpha + PixelBytes(it->width, it->height));
+        return true;
+    }
+    return false;
+}
+
+void DpIconDiskCache::Store(const DpIconCacheKey& key, const DpGlyphBitmap& mask) {
+    if (mask.width <= 0 || mask.height <= 0
+        || mask.width > UINT16_MAX || mask.height > UINT16_MAX
+        || mask.alpha.size() != PixelBytes(mask.width, mask.height)) {
+        return;
+    }
+    m_pending[key] = mask;
+}
+
+bool DpIconDiskCache::Save(const std::function<bool(const DpIconCacheKey&)>& keep) {
+    if (m_path.empty()) {
+        return false;
+    }
+
+    // Fusion (triée) des entrées projetées encore valides et des nouvelles
+    struct Source {
+        DpIconCacheKey key;
+        int width;
+        int height;
+        const uint8_t* alpha;
+    };
+    std::vector<Source> sources;
+    sources.reserve(m_count + m_pending.size());
+
+    bool dropped = false;
+    const DiskEntry* entries = m_count > 0 ? Entries(m_file) : nullptr;
+    for (size_t i = 0; i < m_count; ++i) {
+        const DiskEntry& e = entries[i];
+        const DpIconCacheKey key = KeyOf(e);
+        if (m_pending.count(key) || (keep && !keep(key))) {
+            dropped = true;
+            continue;
+        }
+        sources.push_back({key, e.width, e.height, m_file.Data() + e.offset});
+    }
+    for (const auto& [key, mask] : m_pending) {
+        sources.push_back({key, mask.width, mask.height, mask.alpha.data()});
+    }
+
+    if (!dropped && m_pending.empty()) {
+        return true;  // Rien à écrire
+    }
+
+    std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) {
+        return a.key < b.key;
+    });
+
+    DiskHeader header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.count = static_cast<uint32_t>(sources.size());
+
+    std::vector<DiskEntry> table(sources.size());
+    uint64_t offset = sizeof(DiskHeader) + sources.size() * sizeof(DiskEntry);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const Source& s = sources[i];
+        DiskEntry& e = table[i];
+        e.fontHash = s.key.fontHash;
+        e.offset = offset;
+        e.rgba = s.key.rgba;
+        e.icon = s.key.icon;
+        e.pixelSize = s.key.pixelSize;
+        e.dpiPercent = s.key.dpiPercent;
+        e.width = static_cast<uint16_t>(s.width);
+        e.height = static_cast<uint16_t>(s.height);
+        e.face = s.key.face;
+        e.reserved = 0;
+        offset += PixelBytes(s.width, s.height);
+    }
+
+    // Écriture dans un fichier temporaire, puis remplacement
+    const wxString tmpPath = m_path + ".tmp";
+    wxFile file;
+    if (!file.Create(tmpPath, true)) {
+        wxLogWarning("Unable to write icon cache: %s", tmpPath);
+        return false;
+    }
+
+    bool ok = file.Write(&header, sizeof(header)) == sizeof(header)
+           && file.Write(table.data(), table.size() * sizeof(DiskEntry)) == table.size() * sizeof(DiskEntry);
+    for (size_t i = 0; ok && i < sources.size(); ++i) {
+        const Source& s = sources[i];
+        const size_t bytes = PixelBytes(s.width, s.height);
+        ok = file.Write(s.alpha, bytes) == bytes;
+    }
+    ok = file.Close() && ok;
+
+    if (!ok) {
+        wxRemoveFile(tmpPath);
+        wxLogWarning("Unable to write icon cache: %s", tmpPath);
+        return false;
+    }
+
+    // La projection doit être libérée avant de remplacer le fichier (Windows).
+    // Les nouvelles entrées ne sont abandonnées qu'une fois le fichier remplacé.
+    m_file.Close();
+    m_count = 0;
+    if (!wxRenameFile(tmpPath, m_path, true)) {
+        wxRemoveFile(tmpPath);
+        wxLogWarning("Unable to replace icon cache: %s", m_path);
+        Open(m_path);  // Ancien fichier de nouveau projeté, m_pending intact
+        return false;
+    }
+
+    m_pending.clear();
+    return Open(m_path);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "DpIconAtlas.h"
+#include "DpMappedFile.h"
+#include <wx/string.h>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * @brief Clé d'une icône rendue : fonte (empreinte + face), icône, taille, DPI et couleur
+ * (0 pour un masque de couverture, commun à toutes les couleurs)
+ */
+struct DpIconCacheKey {
+    uint64_t fontHash = 0;    // Empreinte du fichier OTF (invalide le cache si la fonte change)
+    uint32_t rgba = 0;        // Couleur 0xRRGGBBAA
+    uint16_t icon = 0;        // DpIcon
+    uint16_t pixelSize = 0;   // Taille demandée, avant mise à l'échelle DPI
+    uint16_t dpiPercent = 100;
+    uint8_t face = 0;         // DpIconFace
+
+    bool operator<(const DpIconCacheKey& other) const;
+    bool operator==(const DpIconCacheKey& other) const;
+};
+
+/**
+ * @brief Cache disque des masques d'icônes, projeté en mémoire au chargement
+ *
+ * Format : en-tête, table d'entrées triée par clé, puis la couverture 8 bits de
+ * chaque entrée. Les masques ne dépendent pas de la couleur : un changement de
+ * thème n'ajoute aucune entrée. La table est lue directement dans la projection,
+ * sans désérialisation.
+ */
+class DpIconDiskCache {
+public:
+    // Projette le cache existant (un fichier absent ou invalide donne un cache vide)
+    bool Open(const wxString& path);
+
+    bool Lookup(const DpIconCacheKey& key, DpGlyphBitmap& out) const;
+    void Store(const DpIconCacheKey& key, const DpGlyphBitmap& mask);
+
+    // Réécrit le fichier : entrées projetées conservées par keep() + nouvelles entrées
+    bool Save(const std::function<bool(const DpIconCacheKey&)>& keep);
+
+    bool IsDirty() const { return !m_pending.empty(); }
+    size_t GetMappedCount() const { return m_count; }
+
+private:
+    wxString m_path;
+    DpMappedFile m_file;
+    size_t m_count = 0;
+    std::map<DpIconCacheKey, DpGlyphBitmap> m_pending;
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+// Énumérations des icônes et des fontes, sans dépendance à wxWidgets
+// (partagées avec DpIconAtlas et DpGlyphRasterizer)
+
+/**
+ * @brief Type de fonte Font Awesome
+ */
+enum class DpFontAwesomeType {
+    Free,   // Font Awesome 6 Free Solid
+    Pro     // Font Awesome 6 Pro Solid
+};
+
+/**
+ * @brief Style des icônes : plein ou contour
+ */
+enum class DpIconStyle {
+    Solid,    // Poids 900
+    Regular   // Poids 400 (contours), uniquement en Free
+};
+
+/**
+ * @brief Fichier de fonte Font Awesome, enregistré à la première demande
+ */
+enum class DpIconFace {
+    FreeSolid,    // Font Awesome 6 Free-Solid-900.otf
+    FreeRegular,  // Font Awesome 6 Free-Regular-400.otf
+    ProSolid      // Font Awesome 6 Pro-Solid-900.otf
+};
+
+constexpr int DpIconFaceCount = static_cast<int>(DpIconFace::ProSolid) + 1;
+
+/**
+ * @brief Énumération des icônes disponibles
+ */
+enum class DpIcon {
+    // Icônes de navigation et UI
+    Mark,              // Marqueur/Repère
+    NavBar,            // Barres de navigation
+    DayNight,          // Soleil/Lune
+    Views,             // Oeil (vues simples)
+    ComboViews,        // Groupe de couches
+    Settings,          // Paramètres
+    LegacySettings,    // Anciens paramètres
+    RoutesWaypoints,   // Routes et waypoints
+    
+    // Icônes de contrôle
+    Close,             // X de fermeture
+    Plus,              // Ajout
+    Minus,             // Suppression
+    ChevronUp,         // Flèche haut
+    ChevronDown,       // Flèche bas
+    ChevronLeft,       // Flèche gauche
+    ChevronRight,      // Flèche droite
+    
+    // Icônes d'état
+    Check,             // Coche de validation
+    Warning,           // Triangle d'avertissement
+    Info,              // Information
+    Error,             // Erreur
+    Circle,            // Circle
+    
+    // Icônes diverses
+    Search,            // Recherche
+    Filter,            // Filtre
+    Sort,              // Tri
+    Refresh,           // Actualiser
+    Save,              // Sauvegarder
+    Open,              // Ouvrir
+    Delete,            // Supprimer
+    Edit,              // Éditer
+    Copy,              // Copier
+    Paste,             // Coller
+    
+    // Icônes système
+    PowerOff,          // Bouton d'arrêt
+    Sleep,             // Mode veille
+    Screenshot,        // Capture d'écran
+    TouchLock,         // Verrouillage tactile
+    Brightness,        // Luminosité
+    Wifi,              // Sans fil
+    Link,              // Lien/Connexion
+    Sun,               // Soleil (mode jour)
+    Moon,              // Lune (mode nuit)
+    
+    // Nouvelles icônes Pro
+    LocationXmark,     // location-xmark (alternative à Mark)
+    XmarkLarge,        // xmark-large (alternative à Close)
+    GaugeLow,          // gauge-low (alternative à NavBar)
+    SidebarFlip,       // sidebar-flip (menu latéral)
+    GridHorizontal,    // grid-horizontal (menu accueil)
+    TableLayout,       // table-layout (combo alternatif)
+    SlidersUp,         // sliders-up (contrôle système)
+    RectanglesMixed,   // rectangles-mixed (combo 2)
+    PlusLarge,         // plus-large (bouton plus)
+    ListTimeline,      // list-timeline (panneau)
+    HouseDay,          // house-day (contrôle système 2)
+    BrightnessLow,     // brightness-low (luminosité faible)
+    BrightnessHigh,    // brightness (luminosité haute)
+	RectangleWide,     // rectangle-wide
+	Square,     		// rectangle-wide
+};
+
+// Nombre d'icônes de l'énumération (à maintenir avec la dernière valeur)
+constexpr int DpIconCount = static_cast<int>(DpIcon::Square) + 1;
+
+// Glyphe dessiné pour une icône absente de toutes les fontes (point d'interrogation)
+constexpr char32_t DpIconMissingGlyph = 0xf128;
@@ -1,13 +1,238 @@
 #include "DpIcons.h"
+#include "DpIconAtlas.h"
+#include "DpGlyphRasterizer.h"
+#include "DpThemeClient.h"
+#include "DpTintBlit.h"
+#include "DpTrace.h"
 #include <wx/window.h>  // Pour wxWindow
 #include <wx/font.h>
+#include <wx/bitmap.h>
+#include <wx/image.h>
+#include <wx/dcmemory.h>
 #include <wx/log.h>
 #include <wx/filefn.h>
 #include <wx/filename.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
 
-// Définition des noms de famille Font Awesome
-const wxString DpIconManager::kFaFamilyName = "Font Awesome 6 Free Solid";
-const wxString DpIconManager::kFaProFamilyName = "Font Awesome 6 Pro Solid";
+namespace {
+    /**
+     * @brief Fichier et nom de famille de chaque face (dans l'ordre de DpIconFace)
+     */
+    struct DpFaceInfo {
+        const char* fileName;
+        const char* familyName;
+    };
+
+    constexpr DpFaceInfo kFaceTable[DpIconFaceCount] = {
+        {"Font Awesome 6 Free-Solid-900.otf",   "Font Awesome 6 Free Solid"},
+        {"Font Awesome 6 Free-Regular-400.otf", "Font Awesome 6 Free Regular"},
+        {"Font Awesome 6 Pro-Solid-900.otf",    "Font Awesome 6 Pro Solid"},
+    };
+
+    /**
+     * @brief Description statique d'une icône (dans l'ordre de l'énumération DpIcon)
+     */
+    struct DpIconInfo {
+        DpIcon icon;
+        char32_t codepoint;
+        std::string_view faName;       // Identifiant Font Awesome
+        std::string_view displayName;  // Nom affiché (GetIconName)
+    };
+
+    constexpr DpIconInfo kIconTable[] = {
+        // Icônes de navigation et UI
+        {DpIcon::Mark,              0xf3c5, "location-dot",         "Mark"},
+        {DpIcon::NavBar,            0xf0c9, "bars",                 "NavBar"},
+        {DpIcon::DayNight,          0xf185, "sun",                  "Day/Night"},
+        {DpIcon::Views,             0xf06e, "eye",                  "Views"},
+        {DpIcon::ComboViews,        0xf5fd, "layer-group",          "Combo Views"},
+        {DpIcon::Settings,          0xf013, "gear",                 "Settings"},
+        {DpIcon::LegacySettings,    0xf0a0, "hard-drive",           "Legacy Settings"},
+        {DpIcon::RoutesWaypoints,   0xf4d7, "route",                "Routes & Waypoints"},
+
+        // Icônes de contrôle
+        {DpIcon::Close,             0xf00d, "xmark",                "Close"},
+        {DpIcon::Plus,              0xf067, "plus",                 "Plus"},
+        {DpIcon::Minus,             0xf068, "minus",                "Minus"},
+        {DpIcon::ChevronUp,         0xf077, "chevron-up",           "Chevron Up"},
+        {DpIcon::ChevronDown,       0xf078, "chevron-down",         "Chevron Down"},
+        {DpIcon::ChevronLeft,       0xf053, "chevron-left",         "Chevron Left"},
+        {DpIcon::ChevronRight,      0xf054, "chevron-right",        "Chevron Right"},
+
+        // Icônes d'état
+        {DpIcon::Check,             0xf00c, "check",                "Check"},
+        {DpIcon::Warning,           0xf071, "triangle-exclamation", "Warning"},
+        {DpIcon::Info,              0xf05a, "circle-info",          "Info"},
+        {DpIcon::Error,             0xf057, "circle-xmark",         "Error"},
+        {DpIcon::Circle,            0xf111, "circle",               "Circle"},
+
+        // Icônes diverses
+        {DpIcon::Search,            0xf002, "magnifying-glass",     "Search"},
+        {DpIcon::Filter,            0xf0b0, "filter",               "Filter"},
+        {DpIcon::Sort,              0xf0dc, "sort",                 "Sort"},
+        {DpIcon::Refresh,           0xf021, "arrows-rotate",        "Refresh"},
+        {DpIcon::Save,              0xf0c7, "floppy-disk",          "Save"},
+        {DpIcon::Open,              0xf07c, "folder-open",          "Open"},
+        {DpIcon::Delete,            0xf2ed, "trash-can",            "Delete"},
+        {DpIcon::Edit,              0xf044, "pen-to-square",        "Edit"},
+        {DpIcon::Copy,              0xf0c5, "copy",                 "Copy"},
+        {DpIcon::Paste,             0xf0ea, "paste",                "Paste"},
+
+        // Icônes système
+        {DpIcon::PowerOff,          0xf011, "power-off",            "Power Off"},
+        {DpIcon::Sleep,             0xf186, "moon",                 "Sleep"},
+        {DpIcon::Screenshot,        0xf030, "camera",               "Screenshot"},
+        {DpIcon::TouchLock,         0xf256, "hand",                 "Touch Lock"},
+        {DpIcon::Brightness,        0xf185, "sun",                  "Brightness"},
+        {DpIcon::Wifi,              0xf1eb, "wifi",                 "Wifi"},
+        {DpIcon::Link,              0xf0c1, "link",                 "Link"},
+        {DpIcon::Sun,               0xf185, "sun",                  "Sun"},
+        {DpIcon::Moon,              0xf186, "moon",                 "Moon"},
+
+        // Nouvelles icônes Pro
+        {DpIcon::LocationXmark,     0xf60e, "location-xmark",       "Location X-Mark"},
+        {DpIcon::XmarkLarge,        0xe59b, "xmark-large",          "X-Mark Large"},
+        {DpIcon::GaugeLow,          0xf627, "gauge-low",            "Gauge Low"},
+        {DpIcon::SidebarFlip,       0xe24f, "sidebar-flip",         "Sidebar Flip"},
+        {DpIcon::GridHorizontal,    0xe307, "grid-horizontal",      "Grid Horizontal"},
+        {DpIcon::TableLayout,       0xe290, "table-layout",         "Table Layout"},
+        {DpIcon::SlidersUp,         0xf3f1, "sliders-up",           "Sliders Up"},
+        {DpIcon::RectanglesMixed,   0xe323, "rectangles-mixed",     "Rectangles Mixed"},
+        {DpIcon::PlusLarge,         0xe59e, "plus-large",           "Plus Large"},
+        {DpIcon::ListTimeline,      0xe1d1, "list-timeline",        "List Timeline"},
+        {DpIcon::HouseDay,          0xe00e, "house-day",            "House Day"},
+        {DpIcon::BrightnessLow,     0xe0ca, "brightness-low",       "Brightness Low"},
+        {DpIcon::BrightnessHigh,    0xe0c9, "brightness",           "Brightness High"},
+        {DpIcon::RectangleWide,     0xf2fc, "rectangle-wide",       "Rectangle Wide"},
+        {DpIcon::Square,            0xf0c8, "square",               "Square"},
+    };
+
+    static_assert(std::size(kIconTable) == static_cast<size_t>(DpIconCount),
+                  "kIconTable must describe every DpIcon");
+
+    constexpr bool IsTableInEnumOrder() {
+        for (size_t i = 0; i < std::size(kIconTable); ++i) {
+            if (static_cast<size_t>(kIconTable[i].icon) != i) return false;
+        }
+        return true;
+    }
+    static_assert(IsTableInEnumOrder(), "kIconTable must follow the DpIcon order");
+
+    // Point d'interrogation, affiché si aucun équivalent n'existe dans la fonte
+    constexpr char32_t kMissingGlyph = DpIconMissingGlyph;
+
+    // Équivalents (noms Font Awesome, par ordre de préférence) des icônes absentes
+    // d'une fonte : icônes Pro en Free, ou absentes de la version Pro installée
+    using DpIconFallbackNames = std::array<std::string_view, 2>;
+
+    constexpr std::array<DpIconFallbackNames, DpIconCount> BuildIconFallbacks() {
+        std::array<DpIconFallbackNames, DpIconCount> fallbacks{};
+        auto set = [&](DpIcon icon, DpIconFallbackNames names) {
+            fallbacks[static_cast<size_t>(icon)] = names;
+        };
+        set(DpIcon::LocationXmark,   {"location-dot"});
+        set(DpIcon::XmarkLarge,      {"xmark"});
+        set(DpIcon::GaugeLow,        {"gauge", "bars"});
+        set(DpIcon::SidebarFlip,     {"table-columns", "bars"});
+        set(DpIcon::GridHorizontal,  {"table-cells"});
+        set(DpIcon::TableLayout,     {"table-cells-large"});
+        set(DpIcon::SlidersUp,       {"sliders"});
+        set(DpIcon::RectanglesMixed, {"object-group", "layer-group"});
+        set(DpIcon::PlusLarge,       {"plus"});
+        set(DpIcon::ListTimeline,    {"list"});
+        set(DpIcon::HouseDay,        {"house"});
+        set(DpIcon::BrightnessLow,   {"sun"});
+        set(DpIcon::BrightnessHigh,  {"sun"});
+        set(DpIcon::RectangleWide,   {"square"});
+        return fallbacks;
+    }
+
+    constexpr std::array<DpIconFallbackNames, DpIconCount> kIconFallbacks = BuildIconFallbacks();
+
+    // ===== Hash parfait (calculé à la compilation) des noms vers DpIcon =====
+    // Clés 0..N-1 : noms Font Awesome ; clés N..2N-1 : noms affichés.
+    // Un nom Font Awesome partagé (ex. "sun") désigne la dernière icône qui l'utilise.
+
+    constexpr size_t kNameKeyCount = 2 * static_cast<size_t>(DpIconCount);
+    constexpr size_t kNameSlots = 2048;  // Puissance de 2, ~20x le nombre de clés
+    static_assert(kNameKeyCount < 255, "Slots are stored on 8 bits");
+
+    constexpr std::string_view NameKeyAt(size_t key) {
+        return key < static_cast<size_t>(DpIconCount)
+            ? kIconTable[key].faName
+            : kIconTable[key - DpIconCount].displayName;
+    }
+
+    constexpr uint32_t NameHash(std::string_view name, uint32_t seed) {
+        uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+        for (char c : name) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash ^ (hash >> 15);
+    }
+
+    constexpr bool IsShadowedKey(size_t key) {
+        for (size_t other = key + 1; other < static_cast<size_t>(DpIconCount); ++other) {
+            if (key < static_cast<size_t>(DpIconCount) && NameKeyAt(other) == NameKeyAt(key)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    constexpr bool HasDuplicateKeys() {
+        for (size_t a = 0; a < kNameKeyCount; ++a) {
+            if (IsShadowedKey(a)) continue;
+            for (size_t b = a + 1; b < kNameKeyCount; ++b) {
+                if (!IsShadowedKey(b) && NameKeyAt(a) == NameKeyAt(b)) return true;
+            }
+        }
+        return false;
+    }
+    static_assert(!HasDuplicateKeys(), "Display names must be unique and differ from Font Awesome names");
+
+    struct DpNameLookup {
+        uint32_t seed;
+        std::array<uint8_t, kNameSlots> slots;  // Index de clé + 1 (0 = vide)
+    };
+
+    // Cherche la première graine sans collision
+    constexpr DpNameLookup BuildNameLookup() {
+        std::array<bool, kNameKeyCount> shadowed{};
+        for (size_t key = 0; key < kNameKeyCount; ++key) {
+            shadowed[key] = IsShadowedKey(key);
+        }
+
+        for (uint32_t seed = 0;; ++seed) {
+            DpNameLookup lookup{seed, {}};
+            bool ok = true;
+            for (size_t key = 0; key < kNameKeyCount && ok; ++key) {
+                if (shadowed[key]) continue;
+                uint8_t& slot = lookup.slots[NameHash(NameKeyAt(key), seed) & (kNameSlots - 1)];
+                ok = (slot == 0);
+                slot = static_cast<uint8_t>(key + 1);
+            }
+            if (ok) return lookup;
+        }
+    }
+
+    constexpr DpNameLookup kNameLookup = BuildNameLookup();
+
+    // Couleur 0xRRGGBBAA (clés de cache)
+    // Projection d'une face pour le rasteriseur (vide si la face est absente)
+    DpGlyphFontData FontDataOf(const DpFontCatalog* catalog) {
+        return catalog ? DpGlyphFontData{catalog->Data(), catalog->Size()} : DpGlyphFontData{};
+    }
+    
+    uint32_t PackRgba(const wxColour& colour) {
+        return (static_cast<uint32_t>(colour.Red()) << 24) | (colour.Green() << 16)
+             | (colour.Blue() << 8) | colour.Alpha();
+    }
+}
 
 // Singleton
 DpIconManager& DpIconManager::Instance() {
@@ -15,97 +240,177 @@ DpIconManager& DpIconManager::Instance() {
     return instance;
 }
 
+DpIconManager::DpIconManager() {
+    // Avant résolution : points de code nominaux dans chaque face
+    for (int face = 0; face < DpIconFaceCount; ++face) {
+        for (const DpIconInfo& info : kIconTable) {
+            SetResolvedGlyph(static_cast<DpIconFace>(face), info.icon, info.codepoint);
+        }
+    }
+    Attach(DpThemeClient::Instance());
+}
+
+// Icônes RGB565 converties une fois par thème : celles de l'ancien thème sont libérées
+void DpIconManager::Attach(DpThemeClient& client) {
+    client.RegisterCallback([this, &client]() {
+        if (client.GetOutputFormat() == DpOutputFormat::RGB565) {
+            ClearRgb565Cache();
+        }
+    });
+}
+
+DpIconManager::~DpIconManager() = default;
+
 // Initialisation
 void DpIconManager::Init(const DpIconCallbacks& callbacks) {
+    DpTraceScope trace("DpIconManager::Init");
     m_callbacks = callbacks;
     m_initialized = true;
-}
-
-// Charge la fonte Font Awesome Free
-bool DpIconManager::LoadFreeFont() {
-    if (!m_initialized || !m_callbacks.getDataPath) {
-        wxLogWarning("DpIconManager not initialized properly");
-        return false;
-    }
     
-    wxFileName fn;
-    fn.SetPath(m_callbacks.getDataPath());
-    fn.AppendDir("data");
-    fn.AppendDir("resources");
-    fn.SetFullName("Font Awesome 6 Free-Solid-900.otf");
-    
-    if (!wxFileExists(fn.GetFullPath())) {
-        wxLogWarning("Font Awesome Free file not found: %s", fn.GetFullPath());
-        return false;
+    if (!m_callbacks.getDataPath) {
+        return;
     }
     
-    if (!wxFont::AddPrivateFont(fn.GetFullPath())) {
-        wxLogWarning("Unable to load Font Awesome Free: %s", fn.GetFullPath());
-        return false;
+    // Pro n'est enregistrée que si elle est utilisée : on vérifie seulement sa présence
+    m_proFontAvailable = wxFileExists(GetFontFilePath(DpIconFace::ProSolid));
+    if (!m_proFontAvailable) {
+        m_currentFontType = DpFontAwesomeType::Free;
     }
     
-    wxLogMessage("Font Awesome Free loaded successfully from: %s", fn.GetFullPath());
-    return true;
+    if (!m_rasterizer) {
+        m_rasterizer = std::make_unique<DpGlyphRasterizer>();
+    }
 }
 
-// Charge la fonte Font Awesome Pro
-bool DpIconManager::LoadProFont() {
-    if (!m_initialized || !m_callbacks.getDataPath) {
-        return false;
-    }
-    
+// Chemin du fichier OTF d'une face
+wxString DpIconManager::GetFontFilePath(DpIconFace face) const {
     wxFileName fn;
     fn.SetPath(m_callbacks.getDataPath());
     fn.AppendDir("data");
     fn.AppendDir("resources");
-    fn.SetFullName("Font Awesome 6 Pro-Solid-900.otf");
+    fn.SetFullName(kFaceTable[static_cast<int>(face)].fileName);
+    return fn.GetFullPath();
+}
+
+// Type de fonte réellement utilisé (Pro seulement si disponible)
+DpFontAwesomeType DpIconManager::GetEffectiveFontType() const {
+    return (m_currentFontType == DpFontAwesomeType::Pro && m_proFontAvailable)
+           ? DpFontAwesomeType::Pro
+           : DpFontAwesomeType::Free;
+}
+
+// Face d'un style pour le type courant (Regular n'existe qu'en Free)
+DpIconFace DpIconManager::GetFace(DpIconStyle style) const {
+    if (style == DpIconStyle::Regular) {
+        return DpIconFace::FreeRegular;
+    }
+    return GetEffectiveFontType() == DpFontAwesomeType::Pro
+           ? DpIconFace::ProSolid
+           : DpIconFace::FreeSolid;
+}
+
+// Enregistre une face auprès de wxWidgets à sa première demande
+bool DpIconManager::EnsureFace(DpIconFace face) const {
+    FaceState& state = m_faceStates[static_cast<int>(face)];
+    if (state != FaceState::Unknown) {
+        return state == FaceState::Registered;
+    }
     
-    if (!wxFileExists(fn.GetFullPath())) {
-        wxLogDebug("Font Awesome Pro file not found: %s", fn.GetFullPath());
+    if (!m_initialized || !m_callbacks.getDataPath) {
+        wxLogWarning("DpIconManager not initialized properly");
         return false;
     }
     
-    if (!wxFont::AddPrivateFont(fn.GetFullPath())) {
-        wxLogDebug("Unable to load Font Awesome Pro: %s", fn.GetFullPath());
+    const wxString path = GetFontFilePath(face);
+    
+    DpTraceScope trace("DpIconManager::EnsureFace");
+    bool registered = false;
+    {
+        DpTraceScope traceAdd("wxFont::AddPrivateFont");
+        registered = wxFileExists(path) && wxFont::AddPrivateFont(path);
+    }
+    if (!registered) {
+        wxLogWarning("Unable to load Font Awesome: %s", path);
+        state = FaceState::Missing;
+        if (face == DpIconFace::ProSolid) {
+            m_proFontAvailable = false;  // Repli sur Free (GetEffectiveFontType)
+        }
         return false;
     }
     
-    m_proFontLoaded = true;
-    wxLogMessage("Font Awesome Pro loaded successfully from: %s", fn.GetFullPath());
+    state = FaceState::Registered;
+    wxLogMessage("%s loaded successfully from: %s", kFaceTable[static_cast<int>(face)].familyName, path);
     return true;
 }
 
-// Charge les fontes Font Awesome
+// Charge la fonte Font Awesome du type courant
 bool DpIconManager::LoadIconFont() {
-    if (m_fontLoaded) {
-        return true;  // Déjà chargée
+    DpTraceScope trace("DpIconManager::LoadIconFont");
+    // Pro inutilisable : repli sur Free
+    return EnsureFace(GetFace(DpIconStyle::Solid)) || EnsureFace(DpIconFace::FreeSolid);
+}
+
+// Projection de l'OTF d'une face et résolution du glyphe de chaque icône (une fois, sous
+// call_once : voir GetCatalog). Sans fichier lisible, les points de code nominaux restent.
+void DpIconManager::LoadFace(DpIconFace face) const {
+    if (face == DpIconFace::ProSolid && !m_proFontAvailable) {
+        return;
     }
     
-    // Essaie d'abord de charger Font Awesome Pro
-    if (LoadProFont()) {
-        m_fontLoaded = true;
-        // Si on a réussi à charger Pro et que c'est le type courant, on garde Pro
-        if (m_currentFontType == DpFontAwesomeType::Pro) {
-            return true;
-        }
+    DpTraceScope trace("DpIconManager::LoadFace");
+    auto opened = std::make_unique<DpFontCatalog>();
+    if (!opened->Open(GetFontFilePath(face))) {
+        wxLogDebug("Unable to open font catalog: %s", GetFontFilePath(face));
+        return;
     }
+    const DpFontCatalog* catalog = opened.get();
+    m_catalogs[static_cast<int>(face)] = std::move(opened);
     
-    // Charge toujours Font Awesome Free (fallback ou choix explicite)
-    if (LoadFreeFont()) {
-        m_fontLoaded = true;
-        // Si on n'a pas pu charger Pro, force Free
-        if (!m_proFontLoaded) {
-            m_currentFontType = DpFontAwesomeType::Free;
+    for (const DpIconInfo& info : kIconTable) {
+        char32_t codepoint = ResolveCodepoint(*catalog, info.icon);
+        if (codepoint != info.codepoint) {
+            // Icône absente de la face (ex. hors du jeu Regular Free) : le glyphe de
+            // remplacement reste dans la même face, dessinable avec la fonte du style
+            if (codepoint == 0) {
+                codepoint = kMissingGlyph;
+            }
+            wxLogDebug("Icon %s resolved to U+%04X in %s",
+                       wxString(info.faName.data(), info.faName.size()),
+                       static_cast<unsigned>(codepoint),
+                       kFaceTable[static_cast<int>(face)].familyName);
         }
-        return true;
+        SetResolvedGlyph(face, info.icon, codepoint);
+    }
+}
+
+char32_t DpIconManager::ResolveCodepoint(const DpFontCatalog& catalog, DpIcon icon) {
+    const size_t index = static_cast<size_t>(icon);
+    if (index >= static_cast<size_t>(DpIconCount)) {
+        return 0;
     }
     
-    return false;
+    if (catalog.HasGlyph(kIconTable[index].codepoint)) {
+        return kIconTable[index].codepoint;
+    }
+    for (std::string_view name : kIconFallbacks[index]) {
+        char32_t codepoint = 0;
+        if (!name.empty() && (codepoint = catalog.FindCodepoint(name)) != 0) {
+            return codepoint;
+        }
+    }
+    return 0;
+}
+
+void DpIconManager::SetResolvedGlyph(DpIconFace face, DpIcon icon, char32_t codepoint) const {
+    DpResolvedGlyph& entry = m_glyphTable[static_cast<int>(face)][static_cast<size_t>(icon)];
+    entry.codepoint = codepoint;
+    entry.face = face;
+    entry.glyph = wxString(wxUniChar(codepoint));
 }
 
 // Définit le type de fonte à utiliser
 void DpIconManager::SetFontType(DpFontAwesomeType type) {
-    if (type == DpFontAwesomeType::Pro && !m_proFontLoaded) {
+    if (type == DpFontAwesomeType::Pro && !m_proFontAvailable) {
         wxLogWarning("Font Awesome Pro not available, falling back to Free");
         m_currentFontType = DpFontAwesomeType::Free;
     } else {
@@ -114,18 +419,16 @@ void DpIconManager::SetFontType(DpFontAwesomeType type) {
 }
 
 // Création d'une police avec mise à l'échelle DPI
-wxFont DpIconManager::CreateScaledIconFont(int pointSize, wxWindow* parent) const {
-    // S'assurer que la fonte est chargée
-    const_cast<DpIconManager*>(this)->LoadIconFont();
-    
-    // Sélectionne le nom de famille en fonction du type actuel
-    wxString familyName = (m_currentFontType == DpFontAwesomeType::Pro && m_proFontLoaded) 
-                          ? kFaProFamilyName 
-                          : kFaFamilyName;
+wxFont DpIconManager::CreateScaledIconFont(int pointSize, wxWindow* parent, DpIconFace face) const {
+    // Face demandée (enregistrée au premier usage), sinon la face Solid courante
+    if (!EnsureFace(face)) {
+        face = GetFace(DpIconStyle::Solid);
+        EnsureFace(face);
+    }
     
     wxFontInfo info(pointSize);
     info.Family(wxFONTFAMILY_DEFAULT)
-        .FaceName(familyName)
+        .FaceName(kFaceTable[static_cast<int>(face)].familyName)
         .Weight(wxFONTWEIGHT_NORMAL)
         .Style(wxFONTSTYLE_NORMAL)
         .AntiAliased(true);
@@ -141,159 +444,344 @@ wxFont DpIconManager::CreateScaledIconFont(int pointSize, wxWindow* parent) cons
 }
 
 // API publique
-wxFont DpIconManager::GetIconFont(int pointSize, wxWindow* parent) const {
-    return CreateScaledIconFont(pointSize, parent);
+wxFont DpIconManager::GetIconFont(int pointSize, wxWindow* parent, DpIconStyle style) const {
+    return CreateScaledIconFont(pointSize, parent, GetFace(style));
+}
+
+wxFont DpIconManager::GetIconFont(DpIcon icon, int pointSize, DpIconStyle style, wxWindow* parent) const {
+    return CreateScaledIconFont(pointSize, parent, GetResolvedGlyph(icon, style).face);
+}
+
+// Rendu d'un glyphe en couverture 8 bits (texte blanc sur fond noir)
+bool DpIconManager::RasterizeIcon(DpIcon icon, int pixelSize, DpGlyphBitmap& out, DpIconStyle style) const {
+    if (pixelSize <= 0) {
+        return false;
+    }
+    
+    const DpResolvedGlyph& resolved = GetResolvedGlyph(icon, style);
+    wxFont font = CreateScaledIconFont(pixelSize, nullptr, resolved.face);
+    font.SetPixelSize(wxSize(0, pixelSize));
+    const wxString& glyph = resolved.glyph;
+    
+    wxMemoryDC dc;
+    dc.SetFont(font);
+    const wxSize extent = dc.GetTextExtent(glyph);
+    const int width = std::max(1, extent.GetWidth());
+    const int height = std::max(1, extent.GetHeight());
+    
+    wxBitmap bitmap(width, height, 24);
+    dc.SelectObject(bitmap);
+    dc.SetBackground(wxBrush(wxColour(0, 0, 0)));
+    dc.Clear();
+    dc.SetTextForeground(wxColour(255, 255, 255));
+    dc.DrawText(glyph, 0, 0);
+    dc.SelectObject(wxNullBitmap);
+    
+    wxImage image = bitmap.ConvertToImage();
+    if (!image.IsOk()) {
+        return false;
+    }
+    
+    // Moyenne RGB : neutralise un éventuel anticrénelage sous-pixel
+    const unsigned char* rgb = image.GetData();
+    out.width = width;
+    out.height = height;
+    out.alpha.resize(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < out.alpha.size(); ++i) {
+        out.alpha[i] = static_cast<uint8_t>((rgb[i * 3] + rgb[i * 3 + 1] + rgb[i * 3 + 2]) / 3);
+    }
+    return true;
+}
+
+// Rendu FreeType, sans wxFont ni état modifié : appelable depuis tout thread
+bool DpIconManager::RenderIconAlpha(DpIcon icon, int pixelSize, DpGlyphBitmap& out, DpIconStyle style) const {
+    if (!m_rasterizer) {
+        return false;
+    }
+    const DpResolvedGlyph& resolved = GetResolvedGlyph(icon, style);
+    return m_rasterizer->Rasterize(resolved.face, FontDataOf(GetCatalog(resolved.face)),
+                                   resolved.codepoint, pixelSize, out);
+}
+
+bool DpIconManager::RenderIconRGBA(DpIcon icon, int pixelSize, const wxColour& colour, DpGlyphRGBA& out,
+                                   DpIconStyle style) const {
+    if (!m_rasterizer) {
+        return false;
+    }
+    const DpResolvedGlyph& resolved = GetResolvedGlyph(icon, style);
+    
+    // Lecture directe dans le cache partagé ; rendu gardé localement si la table est pleine
+    DpGlyphBitmap uncached;
+    const DpGlyphBitmap* glyph = m_rasterizer->GetGlyph(resolved.face, FontDataOf(GetCatalog(resolved.face)),
+                                                        resolved.codepoint, pixelSize, &uncached);
+    if (!glyph) {
+        return false;
+    }
+    
+    // Couleur unie, couverture dans l'alpha (comme GetIconBitmap)
+    const uint8_t r = colour.Red(), g = colour.Green(), b = colour.Blue(), a = colour.Alpha();
+    out.width = glyph->width;
+    out.height = glyph->height;
+    out.rgba.resize(glyph->alpha.size() * 4);
+    for (size_t i = 0; i < glyph->alpha.size(); ++i) {
+        out.rgba[i * 4] = r;
+        out.rgba[i * 4 + 1] = g;
+        out.rgba[i * 4 + 2] = b;
+        out.rgba[i * 4 + 3] = static_cast<uint8_t>(glyph->alpha[i] * a / 255);
+    }
+    return true;
+}
+
+// Export de toutes les icônes dans un atlas GL
+bool DpIconManager::BuildIconAtlas(int pixelSize, DpAtlasFormat format, int maxMipLevels, DpIconAtlas& out) const {
+    std::vector<DpGlyphBitmap> glyphs(DpIconCount);
+    for (int i = 0; i < DpIconCount; ++i) {
+        if (!RasterizeIcon(static_cast<DpIcon>(i), pixelSize, glyphs[i])) {
+            wxLogWarning("Unable to rasterize icon %d for atlas", i);
+            return false;
+        }
+    }
+    
+    if (!DpIconAtlas::Build(glyphs, format, maxMipLevels, out)) {
+        wxLogWarning("Unable to pack icon atlas (%d px)", pixelSize);
+        return false;
+    }
+    return true;
 }
 
-wxString DpIconManager::GetIconGlyph(DpIcon icon) const {
-    auto& iconMap = GetIconMap();
-    auto it = iconMap.find(icon);
-    if (it != iconMap.end()) {
+// Empreinte du fichier OTF, calculée une fois par session : seul l'en-tête est lu
+uint64_t DpIconManager::GetFontFileHash(DpIconFace face) {
+    if (static_cast<int>(face) < 0 || static_cast<int>(face) >= DpIconFaceCount) {
+        return 0;
+    }
+    uint64_t& hash = m_fontHashes[static_cast<int>(face)];
+    if (hash == 0) {
+        if (const DpFontCatalog* catalog = GetCatalog(face)) {
+            hash = DpFontCatalog::Fingerprint(catalog->Data(), catalog->Size());
+        }
+    }
+    return hash;
+}
+
+// Cache disque, ouvert au premier usage dans <data>/cache
+DpIconDiskCache* DpIconManager::GetDiskCache() {
+    if (!m_diskCache) {
+        if (!m_initialized || !m_callbacks.getDataPath) {
+            return nullptr;
+        }
+        
+        wxFileName fn;
+        fn.SetPath(m_callbacks.getDataPath());
+        fn.AppendDir("data");
+        fn.AppendDir("cache");
+        fn.SetFullName("DpIcons.cache");
+        if (!fn.DirExists() && !fn.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+            wxLogDebug("Unable to create icon cache directory: %s", fn.GetPath());
+        }
+        
+        m_diskCache = std::make_unique<DpIconDiskCache>();
+        m_diskCache->Open(fn.GetFullPath());
+    }
+    return m_diskCache.get();
+}
+
+// Icône rendue en couleur : seul le masque est mis en cache, la teinte est refaite à chaque appel
+wxBitmap DpIconManager::GetIconBitmap(DpIcon icon, int pixelSize, const wxColour& colour, wxWindow* parent,
+                                      DpIconStyle style) {
+    static DpTraceOnce firstRender;
+    DpTraceScope trace("DpIconManager first icon render", firstRender.First());
+    
+    const DpGlyphBitmap* glyph = GetIconMask(icon, pixelSize, parent, style);
+    if (!glyph) {
+        return wxNullBitmap;
+    }
+    
+    // Couleur unie, couverture du glyphe dans le canal alpha
+    wxImage image(glyph->width, glyph->height, false);
+    image.InitAlpha();
+    unsigned char* rgb = image.GetData();
+    unsigned char* alpha = image.GetAlpha();
+    for (size_t i = 0; i < glyph->alpha.size(); ++i) {
+        rgb[i * 3] = colour.Red();
+        rgb[i * 3 + 1] = colour.Green();
+        rgb[i * 3 + 2] = colour.Blue();
+        alpha[i] = static_cast<unsigned char>(glyph->alpha[i] * colour.Alpha() / 255);
+    }
+    return wxBitmap(image);
+}
+
+// Masque de couverture, rendu une fois par (icône, taille, DPI, face) quelle que soit la couleur
+const DpGlyphBitmap* DpIconManager::GetIconMask(DpIcon icon, int pixelSize, wxWindow* parent, DpIconStyle style) {
+    const double scale = parent ? parent->GetDPIScaleFactor() : 1.0;
+    const DpIconFace face = GetResolvedGlyph(icon, style).face;
+    
+    DpIconCacheKey key;
+    key.fontHash = GetFontFileHash(face);
+    key.face = static_cast<uint8_t>(face);
+    key.icon = static_cast<uint16_t>(icon);
+    key.pixelSize = static_cast<uint16_t>(pixelSize);
+    key.dpiPercent = static_cast<uint16_t>(std::lround(scale * 100.0));
+    
+    auto it = m_maskCache.find(key);
+    if (it != m_maskCache.end()) {
+        return it->second.get();
+    }
+    
+    auto mask = std::make_unique<DpGlyphBitmap>();
+    DpIconDiskCache* diskCache = key.fontHash != 0 ? GetDiskCache() : nullptr;
+    if (!diskCache || !diskCache->Lookup(key, *mask)) {
+        if (!RasterizeIcon(icon, static_cast<int>(std::lround(pixelSize * scale)), *mask, style)) {
+            return nullptr;
+        }
+        if (diskCache) {
+            diskCache->Store(key, *mask);
+        }
+    }
+    return (m_maskCache[key] = std::move(mask)).get();
+}
+
+// Teinte au dessin : seul le masque est mis en cache
+bool DpIconManager::DrawIcon(wxImage& target, int x, int y, DpIcon icon, int pixelSize, const wxColour& colour,
+                             wxWindow* parent, DpIconStyle style) {
+    const DpGlyphBitmap* mask = GetIconMask(icon, pixelSize, parent, style);
+    if (!mask || !target.IsOk()) {
+        return false;
+    }
+    DpTintBlit(target, x, y, *mask, colour);
+    return true;
+}
+
+bool DpIconManager::DrawIcon(uint8_t* rgba, int width, int height, int stride, int x, int y, DpIcon icon,
+                             int pixelSize, const wxColour& colour, DpIconStyle style) {
+    const DpGlyphBitmap* mask = GetIconMask(icon, pixelSize, nullptr, style);
+    if (!mask || !rgba) {
+        return false;
+    }
+    DpTintBlitRGBA(rgba, width, height, stride, x, y, *mask, colour);
+    return true;
+}
+
+// Icône pour framebuffer 16 bits : composition opaque sur le fond, puis conversion tramée
+const DpRgb565Bitmap& DpIconManager::GetIconBitmap565(DpIcon icon, int pixelSize, const wxColour& colour,
+                                                      const wxColour& background, DpIconStyle style) {
+    DpIconCacheKey key;
+    key.face = static_cast<uint8_t>(GetResolvedGlyph(icon, style).face);
+    key.icon = static_cast<uint16_t>(icon);
+    key.pixelSize = static_cast<uint16_t>(pixelSize);
+    key.rgba = PackRgba(colour);
+    
+    const auto cacheKey = std::make_pair(key, PackRgba(background));
+    auto it = m_rgb565Cache.find(cacheKey);
+    if (it != m_rgb565Cache.end()) {
         return it->second;
     }
+    
+    DpRgb565Bitmap& bitmap = m_rgb565Cache[cacheKey];
+    const DpGlyphBitmap* glyph = GetIconMask(icon, pixelSize, nullptr, style);
+    if (!glyph) {
+        return bitmap;  // Vide
+    }
+    
+    // Pas d'alpha en 16 bits : la couverture mélange la couleur et le fond opaque
+    std::vector<uint8_t> rgba(glyph->alpha.size() * 4);
+    for (size_t i = 0; i < glyph->alpha.size(); ++i) {
+        rgba[i * 4] = background.Red();
+        rgba[i * 4 + 1] = background.Green();
+        rgba[i * 4 + 2] = background.Blue();
+        rgba[i * 4 + 3] = 255;
+    }
+    DpTintBlitRGBA(rgba.data(), glyph->width, glyph->height, glyph->width * 4, 0, 0, *glyph, colour);
+    
+    bitmap.width = glyph->width;
+    bitmap.height = glyph->height;
+    bitmap.pixels.resize(glyph->alpha.size());
+    DpConvertToRgb565(rgba.data(), glyph->width, glyph->height, bitmap.pixels.data(), true);
+    return bitmap;
+}
+
+// Sauvegarde des masques sur disque ; les entrées d'une ancienne version de fonte sont supprimées
+bool DpIconManager::SaveIconCache() {
+    if (!m_diskCache) {
+        return true;
+    }
+    
+    return m_diskCache->Save([this](const DpIconCacheKey& key) {
+        if (key.face >= DpIconFaceCount || key.icon >= DpIconCount) {
+            return false;
+        }
+        // Empreinte connue seulement des faces utilisées pendant la session : les autres
+        // entrées sont gardées sans ouvrir leur fichier
+        const uint64_t current = m_fontHashes[key.face];
+        return current == 0 || current == key.fontHash;
+    });
+}
+
+// Entrée de la table de résolution, depuis tout thread : la face est résolue à sa
+// première demande, les lectures suivantes ne prennent aucun verrou
+const DpResolvedGlyph& DpIconManager::GetResolvedGlyph(DpIcon icon, DpIconStyle style) const {
+    const size_t index = static_cast<size_t>(icon);
+    if (index < static_cast<size_t>(DpIconCount)) {
+        const DpIconFace face = GetFace(style);
+        GetCatalog(face);
+        return m_glyphTable[static_cast<int>(face)][index];
+    }
     // Retourne une icône par défaut (point d'interrogation)
-    return wxString::FromUTF8(u8"\uf128");
+    static const DpResolvedGlyph missing{kMissingGlyph, DpIconFace::FreeSolid, wxString(wxUniChar(kMissingGlyph))};
+    return missing;
+}
+
+const wxString& DpIconManager::GetIconGlyph(DpIcon icon, DpIconStyle style) const {
+    return GetResolvedGlyph(icon, style).glyph;
+}
+
+char32_t DpIconManager::GetIconCodepoint(DpIcon icon, DpIconStyle style) const {
+    return GetResolvedGlyph(icon, style).codepoint;
 }
 
 wxString DpIconManager::GetIconName(DpIcon icon) const {
-    auto& nameMap = GetNameMap();
-    auto it = nameMap.find(icon);
-    if (it != nameMap.end()) {
-        return it->second;
+    const int index = static_cast<int>(icon);
+    if (index >= 0 && index < DpIconCount) {
+        const std::string_view name = kIconTable[index].displayName;
+        return wxString::FromUTF8(name.data(), name.size());
     }
     return "Unknown";
 }
 
-// Map statique des glyphes
-std::map<DpIcon, wxString> DpIconManager::GetIconMap() {
-    static std::map<DpIcon, wxString> iconMap = {
-        // Icônes de navigation et UI
-        {DpIcon::Mark,              wxString::FromUTF8(u8"\uf3c5")},  // location-dot
-        {DpIcon::NavBar,            wxString::FromUTF8(u8"\uf0c9")},  // bars
-        {DpIcon::DayNight,          wxString::FromUTF8(u8"\uf185")},  // sun
-        {DpIcon::Views,             wxString::FromUTF8(u8"\uf06e")},  // eye
-        {DpIcon::ComboViews,        wxString::FromUTF8(u8"\uf5fd")},  // layer-group
-        {DpIcon::Settings,          wxString::FromUTF8(u8"\uf013")},  // gear
-        {DpIcon::LegacySettings,    wxString::FromUTF8(u8"\uf0a0")},  // sliders-h
-        {DpIcon::RoutesWaypoints,   wxString::FromUTF8(u8"\uf4d7")},  // route
-        
-        // Icônes de contrôle
-        {DpIcon::Close,             wxString::FromUTF8(u8"\uf00d")},  // xmark
-        {DpIcon::Plus,              wxString::FromUTF8(u8"\uf067")},  // plus
-        {DpIcon::Minus,             wxString::FromUTF8(u8"\uf068")},  // minus
-        {DpIcon::ChevronUp,         wxString::FromUTF8(u8"\uf077")},  // chevron-up
-        {DpIcon::ChevronDown,       wxString::FromUTF8(u8"\uf078")},  // chevron-down
-        {DpIcon::ChevronLeft,       wxString::FromUTF8(u8"\uf053")},  // chevron-left
-        {DpIcon::ChevronRight,      wxString::FromUTF8(u8"\uf054")},  // chevron-right
-        
-        // Icônes d'état
-        {DpIcon::Check,             wxString::FromUTF8(u8"\uf00c")},  // check
-        {DpIcon::Warning,           wxString::FromUTF8(u8"\uf071")},  // triangle-exclamation
-        {DpIcon::Info,              wxString::FromUTF8(u8"\uf05a")},  // circle-info
-        {DpIcon::Error,             wxString::FromUTF8(u8"\uf057")},  // circle-xmark
-        {DpIcon::Circle,            wxString::FromUTF8(u8"\uf111")},  // circle (cercle plein)
-        
-        // Icônes diverses
-        {DpIcon::Search,            wxString::FromUTF8(u8"\uf002")},  // magnifying-glass
-        {DpIcon::Filter,            wxString::FromUTF8(u8"\uf0b0")},  // filter
-        {DpIcon::Sort,              wxString::FromUTF8(u8"\uf0dc")},  // sort
-        {DpIcon::Refresh,           wxString::FromUTF8(u8"\uf021")},  // arrows-rotate
-        {DpIcon::Save,              wxString::FromUTF8(u8"\uf0c7")},  // floppy-disk
-        {DpIcon::Open,              wxString::FromUTF8(u8"\uf07c")},  // folder-open
-        {DpIcon::Delete,            wxString::FromUTF8(u8"\uf2ed")},  // trash-can
-        {DpIcon::Edit,              wxString::FromUTF8(u8"\uf044")},  // pen-to-square
-        {DpIcon::Copy,              wxString::FromUTF8(u8"\uf0c5")},  // copy
-        {DpIcon::Paste,             wxString::FromUTF8(u8"\uf0ea")},  // clipboard
-        
-        // Icônes système
-        {DpIcon::PowerOff,          wxString::FromUTF8(u8"\uf011")},  // power-off
-        {DpIcon::Sleep,             wxString::FromUTF8(u8"\uf186")},  // moon
-        {DpIcon::Screenshot,        wxString::FromUTF8(u8"\uf030")},  // camera
-        {DpIcon::TouchLock,         wxString::FromUTF8(u8"\uf256")},  // hand
-        {DpIcon::Brightness,        wxString::FromUTF8(u8"\uf185")},  // sun
-        {DpIcon::Wifi,              wxString::FromUTF8(u8"\uf1eb")},  // wifi
-        {DpIcon::Link,              wxString::FromUTF8(u8"\uf0c1")},  // link
-        {DpIcon::Sun,               wxString::FromUTF8(u8"\uf185")},  // sun
-        {DpIcon::Moon,              wxString::FromUTF8(u8"\uf186")},  // moon
-        
-        // Nouvelles icônes Pro
-        {DpIcon::LocationXmark,     wxString::FromUTF8(u8"\uf60e")},  // location-xmark
-        {DpIcon::XmarkLarge,        wxString::FromUTF8(u8"\ue59b")},  // xmark-large
-        {DpIcon::GaugeLow,          wxString::FromUTF8(u8"\uf627")},  // gauge-low
-        {DpIcon::SidebarFlip,       wxString::FromUTF8(u8"\ue24f")},  // sidebar-flip
-        {DpIcon::GridHorizontal,    wxString::FromUTF8(u8"\ue307")},  // grid-horizontal
-        {DpIcon::TableLayout,       wxString::FromUTF8(u8"\ue290")},  // table-layout
-        {DpIcon::SlidersUp,         wxString::FromUTF8(u8"\uf3f1")},  // sliders-up
-        {DpIcon::RectanglesMixed,   wxString::FromUTF8(u8"\ue323")},  // rectangles-mixed
-        {DpIcon::PlusLarge,         wxString::FromUTF8(u8"\ue59e")},  // plus-large
-        {DpIcon::ListTimeline,      wxString::FromUTF8(u8"\ue1d1")},  // list-timeline
-        {DpIcon::HouseDay,          wxString::FromUTF8(u8"\ue00e")},  // house-day
-        {DpIcon::BrightnessLow,     wxString::FromUTF8(u8"\ue0ca")},  // brightness-low
-        {DpIcon::BrightnessHigh,    wxString::FromUTF8(u8"\ue0c9")},  // brightness
-		{DpIcon::RectangleWide,     wxString::FromUTF8(u8"\uf2fc")},  // rectangle-wide
-		{DpIcon::Square,            wxString::FromUTF8(u8"\uf0c8")},  // Square
-    };
-    return iconMap;
-}
-
-// Map statique des noms
-std::map<DpIcon, wxString> DpIconManager::GetNameMap() {
-    static std::map<DpIcon, wxString> nameMap = {
-        {DpIcon::Mark,              "Mark"},
-        {DpIcon::NavBar,            "NavBar"},
-        {DpIcon::DayNight,          "Day/Night"},
-        {DpIcon::Views,             "Views"},
-        {DpIcon::ComboViews,        "Combo Views"},
-        {DpIcon::Settings,          "Settings"},
-        {DpIcon::LegacySettings,    "Legacy Settings"},
-        {DpIcon::RoutesWaypoints,   "Routes & Waypoints"},
-        {DpIcon::Close,             "Close"},
-        {DpIcon::Plus,              "Plus"},
-        {DpIcon::Minus,             "Minus"},
-        {DpIcon::ChevronUp,         "Chevron Up"},
-        {DpIcon::ChevronDown,       "Chevron Down"},
-        {DpIcon::ChevronLeft,       "Chevron Left"},
-        {DpIcon::ChevronRight,      "Chevron Right"},
-        {DpIcon::Check,             "Check"},
-        {DpIcon::Warning,           "Warning"},
-        {DpIcon::Info,              "Info"},
-        {DpIcon::Error,             "Error"},
-        {DpIcon::Circle,            "Circle"},
-        {DpIcon::Search,            "Search"},
-        {DpIcon::Filter,            "Filter"},
-        {DpIcon::Sort,              "Sort"},
-        {DpIcon::Refresh,           "Refresh"},
-        {DpIcon::Save,              "Save"},
-        {DpIcon::Open,              "Open"},
-        {DpIcon::Delete,            "Delete"},
-        {DpIcon::Edit,              "Edit"},
-        {DpIcon::Copy,              "Copy"},
-        {DpIcon::Paste,             "Paste"},
-        {DpIcon::PowerOff,          "Power Off"},
-        {DpIcon::Sleep,             "Sleep"},
-        {DpIcon::Screenshot,        "Screenshot"},
-        {DpIcon::TouchLock,         "Touch Lock"},
-        {DpIcon::Brightness,        "Brightness"},
-        {DpIcon::Wifi,              "Wifi"},
-        {DpIcon::Link,              "Link"},
-        {DpIcon::Sun,               "Sun"},
-        {DpIcon::Moon,              "Moon"},
-        {DpIcon::LocationXmark,     "Location X-Mark"},
-        {DpIcon::XmarkLarge,        "X-Mark Large"},
-        {DpIcon::GaugeLow,          "Gauge Low"},
-        {DpIcon::SidebarFlip,       "Sidebar Flip"},
-        {DpIcon::GridHorizontal,    "Grid Horizontal"},
-        {DpIcon::TableLayout,       "Table Layout"},
-        {DpIcon::SlidersUp,         "Sliders Up"},
-        {DpIcon::RectanglesMixed,   "Rectangles Mixed"},
-        {DpIcon::PlusLarge,         "Plus Large"},
-        {DpIcon::ListTimeline,      "List Timeline"},
-        {DpIcon::HouseDay,          "House Day"},
-        {DpIcon::BrightnessLow,     "Brightness Low"},
-        {DpIcon::BrightnessHigh,    "Brightness High"},
-		{DpIcon::RectangleWide,     "Rectangle Wide"},
-		{DpIcon::Square,    		"Square"},
-		
-    };
-    return nameMap;
-}
\ No newline at end of file
+std::string_view DpIconManager::GetIconFaName(DpIcon icon) {
+    const int index = static_cast<int>(icon);
+    if (index >= 0 && index < DpIconCount) {
+        return kIconTable[index].faName;
+    }
+    return {};
+}
+
+// Catalogue d'une face, ouvert et résolu à la première demande ; nullptr si le fichier est
+// absent ou illisible, ou avant Init
+const DpFontCatalog* DpIconManager::GetCatalog(DpIconFace face) const {
+    const int index = static_cast<int>(face);
+    if (index < 0 || index >= DpIconFaceCount || !m_initialized || !m_callbacks.getDataPath) {
+        return nullptr;
+    }
+    std::call_once(m_faceLoaded[index], [this, face]() { LoadFace(face); });
+    return m_catalogs[index].get();
+}
+
+wxString DpIconManager::GetGlyphByName(std::string_view name, DpIconStyle style) const {
+    const DpFontCatalog* catalog = GetCatalog(GetFace(style));
+    const char32_t codepoint = catalog ? catalog->FindCodepoint(name) : 0;
+    return codepoint ? wxString(wxUniChar(codepoint)) : wxString();
+}
+
+bool DpIconManager::HasGlyph(char32_t codepoint, DpIconStyle style) const {
+    const DpFontCatalog* catalog = GetCatalog(GetFace(style));
+    return catalog && catalog->HasGlyph(codepoint);
+}
+
+// Recherche inverse : un hash, une case, une comparaison
+std::optional<DpIcon> DpIconManager::FindIcon(std::string_view name) {
+    const uint8_t slot = kNameLookup.slots[NameHash(name, kNameLookup.seed) & (kNameSlots - 1)];
+    if (slot == 0 || NameKeyAt(slot - 1) != name) {
+        return std::nullopt;
+    }
+    return kIconTable[(slot - 1) % DpIconCount].icon;
+}
@@ -1,91 +1,42 @@
 #pragma once
 
+#include "DpFontCatalog.h"
+#include "DpIconCache.h"
+#include "DpIconTypes.h"
+#include "DpRgb565.h"
 #include <wx/string.h>
 #include <wx/font.h>
 #include <wx/filename.h>
+#include <wx/bitmap.h>
+#include <wx/colour.h>
 #include <map>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <functional>
+#include <optional>
+#include <string_view>
 
 // Forward declaration
 class wxWindow;
+class wxImage;
 
-/**
- * @brief Type de fonte Font Awesome
- */
-enum class DpFontAwesomeType {
-    Free,   // Font Awesome 6 Free Solid
-    Pro     // Font Awesome 6 Pro Solid
-};
+// Déclarations anticipées (voir DpIconAtlas.h et DpGlyphRasterizer.h)
+struct DpGlyphBitmap;
+struct DpIconAtlas;
+enum class DpAtlasFormat;
+struct DpGlyphRGBA;
+class DpGlyphRasterizer;
+class DpThemeClient;
 
 /**
- * @brief Énumération des icônes disponibles
+ * @brief Glyphe résolu d'une icône dans une face
  */
-enum class DpIcon {
-    // Icônes de navigation et UI
-    Mark,              // Marqueur/Repère
-    NavBar,            // Barres de navigation
-    DayNight,          // Soleil/Lune
-    Views,             // Oeil (vues simples)
-    ComboViews,        // Groupe de couches
-    Settings,          // Paramètres
-    LegacySettings,    // Anciens paramètres
-    RoutesWaypoints,   // Routes et waypoints
-    
-    // Icônes de contrôle
-    Close,             // X de fermeture
-    Plus,              // Ajout
-    Minus,             // Suppression
-    ChevronUp,         // Flèche haut
-    ChevronDown,       // Flèche bas
-    ChevronLeft,       // Flèche gauche
-    ChevronRight,      // Flèche droite
-    
-    // Icônes d'état
-    Check,             // Coche de validation
-    Warning,           // Triangle d'avertissement
-    Info,              // Information
-    Error,             // Erreur
-    Circle,            // Circle
-    
-    // Icônes diverses
-    Search,            // Recherche
-    Filter,            // Filtre
-    Sort,              // Tri
-    Refresh,           // Actualiser
-    Save,              // Sauvegarder
-    Open,              // Ouvrir
-    Delete,            // Supprimer
-    Edit,              // Éditer
-    Copy,              // Copier
-    Paste,             // Coller
-    
-    // Icônes système
-    PowerOff,          // Bouton d'arrêt
-    Sleep,             // Mode veille
-    Screenshot,        // Capture d'écran
-    TouchLock,         // Verrouillage tactile
-    Brightness,        // Luminosité
-    Wifi,              // Sans fil
-    Link,              // Lien/Connexion
-    Sun,               // Soleil (mode jour)
-    Moon,              // Lune (mode nuit)
-    
-    // Nouvelles icônes Pro
-    LocationXmark,     // location-xmark (alternative à Mark)
-    XmarkLarge,        // xmark-large (alternative à Close)
-    GaugeLow,          // gauge-low (alternative à NavBar)
-    SidebarFlip,       // sidebar-flip (menu latéral)
-    GridHorizontal,    // grid-horizontal (menu accueil)
-    TableLayout,       // table-layout (combo alternatif)
-    SlidersUp,         // sliders-up (contrôle système)
-    RectanglesMixed,   // rectangles-mixed (combo 2)
-    PlusLarge,         // plus-large (bouton plus)
-    ListTimeline,      // list-timeline (panneau)
-    HouseDay,          // house-day (contrôle système 2)
-    BrightnessLow,     // brightness-low (luminosité faible)
-    BrightnessHigh,    // brightness (luminosité haute)
-	RectangleWide,     // rectangle-wide
-	Square,     		// rectangle-wide
+struct DpResolvedGlyph {
+    char32_t codepoint = 0;
+    DpIconFace face = DpIconFace::FreeSolid;  // Fonte qui fournit le glyphe
+    wxString glyph;
 };
 
 /**
@@ -102,30 +53,100 @@ class DpIconManager {
 public:
     static DpIconManager& Instance();
     
-    // Initialisation avec callbacks
+    // Initialisation avec callbacks, avant tout rendu depuis un autre thread. Aucune face
+    // n'est ouverte ici : chacune est projetée et résolue à sa première utilisation.
     void Init(const DpIconCallbacks& callbacks);
     
-    // Charge la fonte Font Awesome (si pas déjà fait)
+    // Enregistre la face Solid du type courant (si pas déjà fait) ;
+    // les autres faces sont enregistrées à leur première utilisation
     bool LoadIconFont();
     
+    // Les méthodes qui passent par wxFont (polices, RasterizeIcon, GetIconBitmap,
+    // atlas) sont réservées au thread principal ; voir RenderIconAlpha/RenderIconRGBA.
+    
     // Nouvelle méthode pour définir le type de fonte à utiliser
     void SetFontType(DpFontAwesomeType type);
     DpFontAwesomeType GetFontType() const { return m_currentFontType; }
     
     // API publique
-    wxString GetIconGlyph(DpIcon icon) const;
+    // Glyphe de l'icône dans la face du style demandé : point de code nominal, sinon un
+    // équivalent présent dans cette face, sinon DpIconMissingGlyph (aucun emprunt à une
+    // autre face). À dessiner avec GetIconFont(icon, ...), ou la fonte du même style.
+    const wxString& GetIconGlyph(DpIcon icon, DpIconStyle style = DpIconStyle::Solid) const;
+    char32_t GetIconCodepoint(DpIcon icon, DpIconStyle style = DpIconStyle::Solid) const;
     wxString GetIconName(DpIcon icon) const;
-    wxFont GetIconFont(int pointSize, wxWindow* parent = nullptr) const;
+    static std::string_view GetIconFaName(DpIcon icon);
+    
+    // Recherche inverse par nom Font Awesome ("xmark-large") ou nom affiché ("X-Mark Large").
+    // Hash parfait calculé à la compilation : ni allocation ni parcours linéaire.
+    static std::optional<DpIcon> FindIcon(std::string_view name);
+    
+    // Point de code dessinable d'une icône dans une fonte (nominal, puis équivalents), 0 si absent
+    static char32_t ResolveCodepoint(const DpFontCatalog& catalog, DpIcon icon);
+    
+    // Mode catalogue : tous les glyphes nommés de la fonte courante, y compris hors DpIcon.
+    // L'OTF est projeté en mémoire et indexé au premier appel.
+    wxString GetGlyphByName(std::string_view name, DpIconStyle style = DpIconStyle::Solid) const;
+    bool HasGlyph(char32_t codepoint, DpIconStyle style = DpIconStyle::Solid) const;
+    
+    // Fonte du style demandé ; la face est enregistrée au premier appel
+    wxFont GetIconFont(int pointSize, wxWindow* parent = nullptr, DpIconStyle style = DpIconStyle::Solid) const;
+    
+    // Fonte de la face qui dessine l'icône (à associer à GetIconGlyph) ; forme à privilégier
+    wxFont GetIconFont(DpIcon icon, int pointSize, DpIconStyle style, wxWindow* parent = nullptr) const;
+    
+    // Rendu d'une icône en bitmap de couverture (blanc sur noir, taille en pixels)
+    bool RasterizeIcon(DpIcon icon, int pixelSize, DpGlyphBitmap& out, DpIconStyle style = DpIconStyle::Solid) const;
+    
+    // Rendu thread-safe, depuis n'importe quel thread une fois Init appelé : FreeType sur
+    // l'OTF projeté (une face par thread), glyphes partagés par un cache lu sans verrou
+    bool RenderIconAlpha(DpIcon icon, int pixelSize, DpGlyphBitmap& out, DpIconStyle style = DpIconStyle::Solid) const;
+    bool RenderIconRGBA(DpIcon icon, int pixelSize, const wxColour& colour, DpGlyphRGBA& out,
+                        DpIconStyle style = DpIconStyle::Solid) const;
+    
+    // Export de toutes les icônes en un atlas unique (UV + niveaux de mip) pour OpenGL
+    bool BuildIconAtlas(int pixelSize, DpAtlasFormat format, int maxMipLevels, DpIconAtlas& out) const;
+    
+    // Icône rendue en couleur : masque de GetIconMask teinté à chaque appel (aucun bitmap par couleur)
+    wxBitmap GetIconBitmap(DpIcon icon, int pixelSize, const wxColour& colour, wxWindow* parent = nullptr,
+                           DpIconStyle style = DpIconStyle::Solid);
+    
+    // Masque de couverture partagé par toutes les couleurs, un par (icône, taille, DPI, face) :
+    // cache mémoire, puis cache disque persistant, puis rendu. Un changement de thème ne rend
+    // ni ne stocke rien de plus. Valide tant que le gestionnaire vit.
+    const DpGlyphBitmap* GetIconMask(DpIcon icon, int pixelSize, wxWindow* parent = nullptr,
+                                     DpIconStyle style = DpIconStyle::Solid);
+    
+    // Teinte le masque au moment du dessin et le compose en (x, y), en pixels de la destination.
+    // La couleur est celle du rôle courant (DpThemeClient::GetColor) : aucun bitmap par couleur.
+    bool DrawIcon(wxImage& target, int x, int y, DpIcon icon, int pixelSize, const wxColour& colour,
+                  wxWindow* parent = nullptr, DpIconStyle style = DpIconStyle::Solid);
+    // Tampon RGBA8888 prémultiplié (textures, surfaces hors écran) ; stride en octets
+    bool DrawIcon(uint8_t* rgba, int width, int height, int stride, int x, int y, DpIcon icon, int pixelSize,
+                  const wxColour& colour, DpIconStyle style = DpIconStyle::Solid);
+    
+    // Icône composée sur un fond puis convertie en RGB565 tramé, une fois par couleur
+    // et par fond (framebuffers 16 bits) ; valide jusqu'à ClearRgb565Cache
+    const DpRgb565Bitmap& GetIconBitmap565(DpIcon icon, int pixelSize, const wxColour& colour,
+                                           const wxColour& background, DpIconStyle style = DpIconStyle::Solid);
+    void ClearRgb565Cache() { m_rgb565Cache.clear(); }
+    
+    // Vide le cache RGB565 à chaque changement de thème du client en sortie RGB565.
+    // Le client du plugin (DpThemeClient::Instance) est suivi dès la création du gestionnaire.
+    void Attach(DpThemeClient& client);
+    
+    // Écrit les nouveaux masques rendus dans le cache disque (à appeler au DeInit du plugin)
+    bool SaveIconCache();
     
     // Vérifie si la fonte est chargée
-    bool IsIconFontLoaded() const { return m_fontLoaded; }
+    bool IsIconFontLoaded() const { return m_faceStates[static_cast<int>(GetFace(DpIconStyle::Solid))] == FaceState::Registered; }
     
     // Nouvelle méthode pour vérifier si Font Awesome Pro est disponible
-    bool IsProFontAvailable() const { return m_proFontLoaded; }
+    bool IsProFontAvailable() const { return m_proFontAvailable; }
     
 private:
-    DpIconManager() = default;
-    ~DpIconManager() = default;
+    DpIconManager();
+    ~DpIconManager();
     
     // Non copiable
     DpIconManager(const DpIconManager&) = delete;
@@ -133,20 +154,43 @@ private:
     
     // Membres privés
     bool m_initialized = false;
-    bool m_fontLoaded = false;
-    bool m_proFontLoaded = false;
-    DpFontAwesomeType m_currentFontType = DpFontAwesomeType::Free;
+    // Lus par RenderIconAlpha/RenderIconRGBA depuis d'autres threads
+    mutable std::atomic<bool> m_proFontAvailable{false};  // Fichier Pro présent (enregistré à la demande)
+    std::atomic<DpFontAwesomeType> m_currentFontType{DpFontAwesomeType::Free};
     DpIconCallbacks m_callbacks;
     
-    static const wxString kFaFamilyName;
-    static const wxString kFaProFamilyName;
+    // Registre des faces : AddPrivateFont n'est appelé qu'à la première demande
+    // (polices wx, thread principal uniquement)
+    enum class FaceState { Unknown, Registered, Missing };
+    mutable std::array<FaceState, DpIconFaceCount> m_faceStates{};
     
-    // Helper internes
-    wxFont CreateScaledIconFont(int pointSize, wxWindow* parent) const;
-    bool LoadProFont();
-    bool LoadFreeFont();
+    // Caches des icônes rendues
+    std::map<DpIconCacheKey, std::unique_ptr<DpGlyphBitmap>> m_maskCache;  // Clé sans couleur (rgba = 0)
+    std::map<std::pair<DpIconCacheKey, uint32_t>, DpRgb565Bitmap> m_rgb565Cache;  // Clé : icône, couleur du fond
+    std::unique_ptr<DpIconDiskCache> m_diskCache;
+    uint64_t m_fontHashes[DpIconFaceCount] = {};  // Empreinte des fichiers OTF, par DpIconFace
+    
+    // Par DpIconFace : catalogue des glyphes (et projection de l'OTF) et table de résolution
+    // [DpIcon], remplis une seule fois par LoadFace à la première demande (depuis tout
+    // thread, sous call_once), puis en lecture seule
+    mutable std::array<std::once_flag, DpIconFaceCount> m_faceLoaded;
+    mutable std::unique_ptr<DpFontCatalog> m_catalogs[DpIconFaceCount];
+    mutable std::array<std::array<DpResolvedGlyph, DpIconCount>, DpIconFaceCount> m_glyphTable;
     
-    // Map des icônes
-    static std::map<DpIcon, wxString> GetIconMap();
-    static std::map<DpIcon, wxString> GetNameMap();
+    // Rendu hors thread principal, créé par Init, sur les projections de m_catalogs
+    // (déclaré après : détruit avant elles)
+    std::unique_ptr<DpGlyphRasterizer> m_rasterizer;
+    
+    // Helper internes
+    wxFont CreateScaledIconFont(int pointSize, wxWindow* parent, DpIconFace face) const;
+    bool EnsureFace(DpIconFace face) const;
+    wxString GetFontFilePath(DpIconFace face) const;
+    DpFontAwesomeType GetEffectiveFontType() const;
+    DpIconFace GetFace(DpIconStyle style) const;
+    const DpResolvedGlyph& GetResolvedGlyph(DpIcon icon, DpIconStyle style) const;
+    const DpFontCatalog* GetCatalog(DpIconFace face) const;
+    void LoadFace(DpIconFace face) const;
+    void SetResolvedGlyph(DpIconFace face, DpIcon icon, char32_t codepoint) const;
+    uint64_t GetFontFileHash(DpIconFace face);
+    DpIconDiskCache* GetDiskCache();
 };
\ No newline at end of file
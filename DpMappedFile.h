@@ -0,0 +1,39 @@
+#pragma once
+
+#include <wx/string.h>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Fichier projeté en mémoire, lecture seule
+ */
+class DpMappedFile {
+public:
+    DpMappedFile() = default;
+    ~DpMappedFile();
+
+    // Non copiable, déplaçable
+    DpMappedFile(const DpMappedFile&) = delete;
+    DpMappedFile& operator=(const DpMappedFile&) = delete;
+    DpMappedFile(DpMappedFile&& other) noexcept;
+    DpMappedFile& operator=(DpMappedFile&& other) noexcept;
+
+    // Projette le fichier ; retourne false s'il est absent, vide ou illisible
+    bool Open(const wxString& path);
+    void Close();
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+// Hash FNV-1a 64 bits (empreinte de fichiers de fonte, clés de cache)
+uint64_t DpHashBytes(const uint8_t* data, size_t size, uint64_t seed = 14695981039346656037ULL);
\ No newline at end of file
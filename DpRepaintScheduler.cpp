@@ -0,0 +1,131 @@
+#include "DpRepaintScheduler.h"
+#include "DpThemeClient.h"
+#include <wx/window.h>
+#include <wx/stopwatch.h>
+#include <algorithm>
+
+DpRepaintScheduler& DpRepaintScheduler::Instance() {
+    static DpRepaintScheduler instance;
+    return instance;
+}
+
+DpRepaintScheduler::DpRepaintScheduler() : DpWindowHooks(HookPaint | HookShow) {
+    Attach(DpThemeClient::Instance());
+}
+
+void DpRepaintScheduler::Attach(DpThemeClient& client) {
+    client.RegisterCallback([this]() { ScheduleThemeChange(); });
+}
+
+void DpRepaintScheduler::Register(wxWindow* window, ApplyThemeFn apply) {
+    if (!window) return;
+
+    if (Entry* entry = Find(window)) {
+        entry->apply = std::move(apply);
+        return;
+    }
+
+    m_entries.push_back({window, std::move(apply), false});
+    HookWindow(window);
+}
+
+void DpRepaintScheduler::Unregister(wxWindow* window) {
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [window](const Entry& e) {
+        return e.window == window;
+    });
+    if (it == m_entries.end()) return;
+
+    UnhookWindow(window);
+    m_entries.erase(it);
+}
+
+void DpRepaintScheduler::ScheduleThemeChange() {
+    for (Entry& entry : m_entries) {
+        entry.dirty = true;
+    }
+    ProcessVisible();
+}
+
+size_t DpRepaintScheduler::GetDirtyCount() const {
+    return std::count_if(m_entries.begin(), m_entries.end(), [](const Entry& e) {
+        return e.dirty;
+    });
+}
+
+bool DpRepaintScheduler::IsHooked(wxWindow* window) const {
+    return std::any_of(m_entries.begin(), m_entries.end(), [window](const Entry& e) {
+        return e.window == window;
+    });
+}
+
+DpRepaintScheduler::Entry* DpRepaintScheduler::Find(wxWindow* window) {
+    for (Entry& entry : m_entries) {
+        if (entry.window == window) return &entry;
+    }
+    return nullptr;
+}
+
+// Le callback peut (dés)enregistrer des fenêtres : entry n'est plus lue après l'appel
+void DpRepaintScheduler::Apply(Entry& entry, bool refresh) {
+    entry.dirty = false;
+    wxWindow* window = entry.window;
+    ApplyThemeFn apply = entry.apply;
+    if (apply) {
+        apply(window);
+    }
+    if (refresh) {
+        window->Refresh();
+    }
+}
+
+// Traite les fenêtres visibles dans le budget, puis rend la main à la boucle d'événements.
+// Les callbacks peuvent (dés)enregistrer des fenêtres : la passe parcourt une copie de la
+// liste des fenêtres en attente et retrouve chaque entrée avant de l'appliquer.
+void DpRepaintScheduler::ProcessVisible() {
+    m_passQueued = false;
+
+    std::vector<wxWindow*> pending;
+    for (const Entry& entry : m_entries) {
+        if (entry.dirty) {
+            pending.push_back(entry.window);
+        }
+    }
+
+    wxStopWatch watch;
+    for (wxWindow* window : pending) {
+        Entry* entry = Find(window);
+        if (!entry || !entry->dirty || window->IsBeingDeleted() || !window->IsShownOnScreen()) {
+            continue;
+        }
+
+        Apply(*entry, true);
+
+        if (watch.Time() >= m_frameBudgetMs) {
+            const bool remaining = std::any_of(m_entries.begin(), m_entries.end(), [](const Entry& e) {
+                return e.dirty && e.window->IsShownOnScreen();
+            });
+            if (remaining && !m_passQueued) {
+                m_passQueued = true;
+                CallAfter(&DpRepaintScheduler::ProcessVisible);
+            }
+            return;
+        }
+    }
+}
+
+void DpRepaintScheduler::OnWindowShown(wxWindow* WXUNUSED(window)) {
+    // Les enfants ne reçoivent pas wxEVT_SHOW : une passe traite ceux devenus visibles
+    if (!m_passQueued && GetDirtyCount() > 0) {
+        m_passQueued = true;
+        CallAfter(&DpRepaintScheduler::ProcessVisible);
+    }
+}
+
+void DpRepaintScheduler::OnWindowPaint(wxWindow* window) {
+    // Fenêtre peinte avant son tour (ou devenue visible sans wxEVT_SHOW) :
+    // le thème est appliqué avant que son propre gestionnaire ne dessine
+    Entry* entry = Find(window);
+    if (entry && entry->dirty) {
+        Apply(*entry, false);
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "DpWindowHooks.h"
+#include <functional>
+#include <vector>
+
+// Forward declaration
+class wxWindow;
+class DpThemeClient;
+
+/**
+ * @brief Ordonnanceur des repeints lors d'un changement de thème
+ *
+ * Les fenêtres visibles sont re-thémées en premier, par tranches limitées par un
+ * budget de temps (la suite est reprise au prochain passage de la boucle d'événements).
+ * Les fenêtres cachées sont seulement marquées ; elles sont re-thémées quand elles
+ * sont montrées ou repeintes.
+ */
+class DpRepaintScheduler : public DpWindowHooks {
+public:
+    // Applique le thème à la fenêtre (couleurs, polices...) ; le Refresh est fait par l'ordonnanceur
+    using ApplyThemeFn = std::function<void(wxWindow*)>;
+
+    static DpRepaintScheduler& Instance();
+
+    // Enregistre une fenêtre (désenregistrée automatiquement à sa destruction).
+    // À appeler après avoir lié le gestionnaire wxEVT_PAINT de la fenêtre.
+    void Register(wxWindow* window, ApplyThemeFn apply = ApplyThemeFn());
+    void Unregister(wxWindow* window);
+
+    // Budget par tranche, en millisecondes
+    void SetFrameBudget(int milliseconds) { m_frameBudgetMs = milliseconds; }
+    int GetFrameBudget() const { return m_frameBudgetMs; }
+
+    // Marque toutes les fenêtres et lance le traitement des visibles
+    void ScheduleThemeChange();
+    
+    // Planifie les repeints à chaque changement de thème du client ; le client du
+    // plugin (DpThemeClient::Instance) est suivi dès la création de l'ordonnanceur
+    void Attach(DpThemeClient& client);
+
+    // Nombre de fenêtres en attente de thème
+    size_t GetDirtyCount() const;
+
+private:
+    DpRepaintScheduler();
+    ~DpRepaintScheduler() override = default;
+
+    // Non copiable
+    DpRepaintScheduler(const DpRepaintScheduler&) = delete;
+    DpRepaintScheduler& operator=(const DpRepaintScheduler&) = delete;
+
+    struct Entry {
+        wxWindow* window;
+        ApplyThemeFn apply;
+        bool dirty;
+    };
+
+    std::vector<Entry> m_entries;
+    int m_frameBudgetMs = 8;
+    bool m_passQueued = false;
+
+    Entry* Find(wxWindow* window);
+    void Apply(Entry& entry, bool refresh);
+    void ProcessVisible();
+
+    bool IsHooked(wxWindow* window) const override;
+    void OnWindowDestroyed(wxWindow* window) override { Unregister(window); }
+    void OnWindowPaint(wxWindow* window) override;
+    void OnWindowShown(wxWindow* window) override;
+};
\ No newline at end of file
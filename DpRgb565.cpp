@@ -0,0 +1,204 @@
+#include "DpRgb565.h"
+#include <algorithm>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DP_RGB565_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DP_RGB565_NEON 1
+#endif
+
+/*
+ * Quantification : c' = c - (c >> 5) (c - (c >> 6) pour le vert) ramène 0..255
+ * sur 0..248 (0..252) de sorte qu'une valeur déjà sur la grille 565, réexpansée
+ * par réplication des bits hauts, retombe exactement sur son niveau quel que soit
+ * le seuil ajouté (0..7, ou 0..3 pour le vert). Sans tramage, le seuil est la
+ * moitié du pas (arrondi).
+ */
+
+namespace {
+    constexpr uint8_t kBayer4[4][4] = {
+        { 0,  8,  2, 10},
+        {12,  4, 14,  6},
+        { 3, 11,  1,  9},
+        {15,  7, 13,  5}
+    };
+
+    constexpr int kRoundRB = 4;  // Demi-pas 5 bits
+    constexpr int kRoundG = 2;   // Demi-pas 6 bits
+
+    inline uint16_t Pack(int r, int g, int b, int thresholdRB, int thresholdG) {
+        const int r5 = (r - (r >> 5) + thresholdRB) >> 3;
+        const int g6 = (g - (g >> 6) + thresholdG) >> 2;
+        const int b5 = (b - (b >> 5) + thresholdRB) >> 3;
+        return static_cast<uint16_t>((r5 << 11) | (g6 << 5) | b5);
+    }
+
+    inline int Channel(uint16_t value, int shift, int bits) {
+        const int v = (value >> shift) & ((1 << bits) - 1);
+        return (v << (8 - bits)) | (v >> (2 * bits - 8));
+    }
+
+    // Une ligne, pixels [x, width) en scalaire
+    void ConvertRowScalar(const uint8_t* rgba, uint16_t* out, int x, int width, int y, bool dither) {
+        for (; x < width; ++x) {
+            const int t = kBayer4[y & 3][x & 3];
+            const uint8_t* p = rgba + static_cast<size_t>(x) * 4;
+            out[x] = dither ? Pack(p[0], p[1], p[2], t >> 1, t >> 2)
+                            : Pack(p[0], p[1], p[2], kRoundRB, kRoundG);
+        }
+    }
+
+#if DP_RGB565_SSE2
+    // 4 pixels RGBA (little-endian) -> 4 valeurs 565 dans les 16 bits bas de chaque mot de 32 bits
+    inline __m128i Pack4(__m128i v, __m128i threshold) {
+        const __m128i maskRB = _mm_set1_epi32(0x00070007);
+        const __m128i maskG = _mm_set1_epi32(0x00000300);
+        const __m128i low = _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 5), maskRB),
+                                         _mm_and_si128(_mm_srli_epi16(v, 6), maskG));
+        v = _mm_add_epi8(_mm_sub_epi8(v, low), threshold);
+
+        const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 3), _mm_set1_epi32(0x1f));
+        const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 10), _mm_set1_epi32(0x3f));
+        const __m128i b = _mm_and_si128(_mm_srli_epi32(v, 19), _mm_set1_epi32(0x1f));
+        const __m128i packed = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(r, 11), _mm_slli_epi32(g, 5)), b);
+
+        // Extension de signe : _mm_packs_epi32 conserve alors les 16 bits tels quels
+        return _mm_srai_epi32(_mm_slli_epi32(packed, 16), 16);
+    }
+
+    void ConvertRow(const uint8_t* rgba, uint16_t* out, int width, int y, bool dither) {
+        // Seuils d'une ligne de la matrice pour 4 pixels : R, G, B, A(0)
+        alignas(16) uint8_t thresholds[16];
+        for (int i = 0; i < 4; ++i) {
+            const int t = kBayer4[y & 3][i];
+            thresholds[i * 4] = static_cast<uint8_t>(dither ? t >> 1 : kRoundRB);
+            thresholds[i * 4 + 1] = static_cast<uint8_t>(dither ? t >> 2 : kRoundG);
+            thresholds[i * 4 + 2] = static_cast<uint8_t>(dither ? t >> 1 : kRoundRB);
+            thresholds[i * 4 + 3] = 0;
+        }
+        const __m128i threshold = _mm_load_si128(reinterpret_cast<const __m128i*>(thresholds));
+
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + static_cast<size_t>(x) * 4));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + static_cast<size_t>(x) * 4 + 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x),
+                             _mm_packs_epi32(Pack4(a, threshold), Pack4(b, threshold)));
+        }
+        ConvertRowScalar(rgba, out, x, width, y, dither);
+    }
+#elif DP_RGB565_NEON
+    void ConvertRow(const uint8_t* rgba, uint16_t* out, int width, int y, bool dither) {
+        uint8_t rb[8], g[8];
+        for (int i = 0; i < 8; ++i) {
+            const int t = kBayer4[y & 3][i & 3];
+            rb[i] = static_cast<uint8_t>(dither ? t >> 1 : kRoundRB);
+            g[i] = static_cast<uint8_t>(dither ? t >> 2 : kRoundG);
+        }
+        const uint8x8_t thresholdRB = vld1_u8(rb);
+        const uint8x8_t thresholdG = vld1_u8(g);
+
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            const uint8x8x4_t px = vld4_u8(rgba + static_cast<size_t>(x) * 4);
+            const uint8x8_t r5 = vshr_n_u8(vadd_u8(vsub_u8(px.val[0], vshr_n_u8(px.val[0], 5)), thresholdRB), 3);
+            const uint8x8_t g6 = vshr_n_u8(vadd_u8(vsub_u8(px.val[1], vshr_n_u8(px.val[1], 6)), thresholdG), 2);
+            const uint8x8_t b5 = vshr_n_u8(vadd_u8(vsub_u8(px.val[2], vshr_n_u8(px.val[2], 5)), thresholdRB), 3);
+            const uint16x8_t packed = vorrq_u16(vorrq_u16(vshlq_n_u16(vmovl_u8(r5), 11),
+                                                          vshlq_n_u16(vmovl_u8(g6), 5)),
+                                                vmovl_u8(b5));
+            vst1q_u16(out + x, packed);
+        }
+        ConvertRowScalar(rgba, out, x, width, y, dither);
+    }
+#else
+    void ConvertRow(const uint8_t* rgba, uint16_t* out, int width, int y, bool dither) {
+        ConvertRowScalar(rgba, out, 0, width, y, dither);
+    }
+#endif
+}
+
+uint16_t DpToRgb565(const wxColour& colour) {
+    return Pack(colour.Red(), colour.Green(), colour.Blue(), kRoundRB, kRoundG);
+}
+
+wxColour DpFromRgb565(uint16_t value) {
+    return wxColour(static_cast<unsigned char>(Channel(value, 11, 5)),
+                    static_cast<unsigned char>(Channel(value, 5, 6)),
+                    static_cast<unsigned char>(Channel(value, 0, 5)));
+}
+
+void DpConvertToRgb565(const uint8_t* rgba, int width, int height, uint16_t* out, bool dither) {
+    for (int y = 0; y < height; ++y) {
+        ConvertRow(rgba + static_cast<size_t>(y) * width * 4, out + static_cast<size_t>(y) * width, width, y, dither);
+    }
+}
+
+void DpRgb565Palette::Build(const DpPalette& source) {
+    std::array<wxColour, DpColorRoleCount> colours;
+    for (int i = 0; i < DpColorRoleCount; ++i) {
+        colours[i] = source[static_cast<DpColorRole>(i)];
+        if (!colours[i].IsOk()) {
+            colours[i] = wxColour(0, 0, 0);
+        }
+    }
+
+    auto sameSource = [&colours](int a, int b) {
+        return colours[a].Red() == colours[b].Red() && colours[a].Green() == colours[b].Green()
+            && colours[a].Blue() == colours[b].Blue();
+    };
+    // La valeur est-elle déjà prise par un rôle de couleur différente ?
+    auto taken = [&](int role, uint16_t value) {
+        for (int k = 0; k < role; ++k) {
+            if (values[k] == value && !sameSource(k, role)) return true;
+        }
+        return false;
+    };
+
+    adjusted = 0;
+    merged.clear();
+    for (int i = 0; i < DpColorRoleCount; ++i) {
+        values[i] = DpToRgb565(colours[i]);
+        if (!taken(i, values[i])) continue;
+
+        // Conflit : on déplace d'un pas le canal le plus écarté de la couleur en conflit
+        int other = 0;
+        while (values[other] != values[i] || sameSource(other, i)) ++other;
+        const int diff[3] = {colours[i].Red() - colours[other].Red(),
+                             colours[i].Green() - colours[other].Green(),
+                             colours[i].Blue() - colours[other].Blue()};
+        const int shifts[3] = {11, 5, 0};
+        const int maxima[3] = {31, 63, 31};
+
+        int order[3] = {0, 1, 2};
+        std::sort(order, order + 3, [&diff](int a, int b) { return std::abs(diff[a]) > std::abs(diff[b]); });
+        for (int c : order) {
+            if (diff[c] == 0) break;
+            const int level = ((values[i] >> shifts[c]) & maxima[c]) + (diff[c] > 0 ? 1 : -1);
+            if (level < 0 || level > maxima[c]) continue;
+            const uint16_t candidate = static_cast<uint16_t>((values[i] & ~(maxima[c] << shifts[c])) | (level << shifts[c]));
+            if (!taken(i, candidate)) {
+                values[i] = candidate;
+                ++adjusted;
+                break;
+            }
+        }
+    }
+
+    // Paires restées confondues
+    for (int i = 0; i < DpColorRoleCount; ++i) {
+        for (int j = i + 1; j < DpColorRoleCount; ++j) {
+            if (values[i] == values[j] && !sameSource(i, j)) {
+                merged.emplace_back(static_cast<DpColorRole>(i), static_cast<DpColorRole>(j));
+            }
+        }
+    }
+
+    palette.colors.clear();
+    for (int i = 0; i < DpColorRoleCount; ++i) {
+        palette.colors[static_cast<DpColorRole>(i)] = DpFromRgb565(values[i]);
+    }
+}
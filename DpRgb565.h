@@ -0,0 +1,49 @@
+#pragma once
+
+#include "DpThemes.h"
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <wx/colour.h>
+
+/**
+ * @brief Format de sortie des couleurs et des icônes
+ */
+enum class DpOutputFormat {
+    RGBA8888,  // Affichage standard
+    RGB565     // Framebuffers 16 bits (installations embarquées)
+};
+
+// Conversions d'une couleur (arrondi au plus proche)
+uint16_t DpToRgb565(const wxColour& colour);
+wxColour DpFromRgb565(uint16_t value);
+
+/**
+ * @brief Palette d'un thème et d'un mode quantifiée en RGB565
+ *
+ * Deux rôles de couleurs différentes qui tombent sur la même valeur 16 bits
+ * (fonds sombres, mode nuit) sont séparés d'un pas de quantification, dans le
+ * sens de leur écart d'origine. Les paires qui n'ont pu être séparées sont listées.
+ */
+struct DpRgb565Palette {
+    std::array<uint16_t, DpColorRoleCount> values{};
+    DpPalette palette;  // Mêmes couleurs, réexpansées en 8 bits (pour DpResolvedPalette)
+    int adjusted = 0;   // Rôles déplacés d'un pas pour rester distincts
+    std::vector<std::pair<DpColorRole, DpColorRole>> merged;
+
+    void Build(const DpPalette& source);
+};
+
+/**
+ * @brief Bitmap RGB565 (pixels contigus, sans padding de ligne)
+ */
+struct DpRgb565Bitmap {
+    int width = 0;
+    int height = 0;
+    std::vector<uint16_t> pixels;
+};
+
+// RGBA8888 (octets R, G, B, A) -> RGB565, alpha ignoré. Tramage ordonné Bayer 4x4
+// optionnel, aligné sur les coordonnées de l'image. SSE2 ou NEON si disponibles.
+void DpConvertToRgb565(const uint8_t* rgba, int width, int height, uint16_t* out, bool dither = true);
@@ -1,8 +1,12 @@
 #include "DpThemeClient.h"
+#include "DpTrace.h"
 #include <wx/jsonval.h>
 #include <wx/jsonreader.h>
 #include <wx/jsonwriter.h>
 #include <wx/fileconf.h>
+#include <wx/log.h>
+#include <algorithm>
+#include <string_view>
 
 // Définition de l'événement
 wxDEFINE_EVENT(EVT_DPTHEME_CHANGED, wxCommandEvent);
@@ -12,7 +16,20 @@ DpThemeClient& DpThemeClient::Instance() {
     return instance;
 }
 
+DpThemeClient::DpThemeClient()
+    : m_cachedProfile(std::make_shared<const DpThemeProfile>()),
+      m_resolved(std::make_shared<const DpResolvedPalette>()),
+      m_replyTimer(this) {
+    Bind(wxEVT_TIMER, &DpThemeClient::OnReplyTimeout, this, m_replyTimer.GetId());
+}
+
+DpThemeClient::~DpThemeClient() {
+    m_replyTimer.Stop();
+}
+
 void DpThemeClient::Init(const wxString& pluginName, const DpThemeClientCallbacks& callbacks) {
+    DpTraceScope trace("DpThemeClient::Init");
+    
     m_pluginName = pluginName;
     m_callbacks = callbacks;
     m_initialized = true;
@@ -26,6 +43,7 @@ void DpThemeClient::Init(const wxString& pluginName, const DpThemeClientCallback
 
 void DpThemeClient::RequestCurrentTheme() {
     if (!m_initialized || !m_callbacks.sendMessage) return;
+    DpTraceScope trace("DpThemeClient::RequestCurrentTheme");
     
     // Construire la requête JSON
     wxJSONValue request;
@@ -39,13 +57,187 @@ void DpThemeClient::RequestCurrentTheme() {
     m_callbacks.sendMessage("DPTHEME_REQUEST", jsonStr);
 }
 
-wxColour DpThemeClient::GetColor(DpColorRole role) const {
-    return (m_mode == DpThemeMode::Night) 
-        ? m_cachedProfile.night[role] 
-        : m_cachedProfile.day[role];
+std::shared_future<DpThemeReply> DpThemeClient::RequestCurrentThemeAsync(int timeoutMs, ThemeReadyCallback callback) {
+    // Thème déjà confirmé : future prêt, callback immédiat
+    if (m_themeConfirmed) {
+        DpThemeReply reply{m_currentTheme, m_mode, true};
+        if (callback) {
+            callback(reply);
+        }
+        std::promise<DpThemeReply> ready;
+        ready.set_value(reply);
+        return ready.get_future().share();
+    }
+    
+    if (callback) {
+        m_readyCallbacks.push_back(std::move(callback));
+    }
+    if (m_replyPending) {
+        return m_replyFuture;  // Une seule requête en vol, le premier délai s'applique
+    }
+    
+    m_replyPending = true;
+    m_replyPromise = std::promise<DpThemeReply>();
+    m_replyFuture = m_replyPromise.get_future().share();
+    std::shared_future<DpThemeReply> future = m_replyFuture;
+    
+    // Sans canal de messages, rien ne viendra : repli immédiat sur la config
+    if (!m_initialized || !m_callbacks.sendMessage) {
+        ResolveReply(false);
+        return future;
+    }
+    
+    // La réponse peut arriver pendant l'envoi (messages synchrones entre plugins)
+    RequestCurrentTheme();
+    if (m_replyPending) {
+        m_replyTimer.StartOnce(std::max(timeoutMs, 0));
+    }
+    return future;
+}
+
+// Fin de l'attente : premier thème reçu (authoritative) ou délai écoulé
+void DpThemeClient::ResolveReply(bool authoritative) {
+    if (authoritative) {
+        m_themeConfirmed = true;
+    }
+    if (!m_replyPending) return;
+    
+    m_replyPending = false;
+    m_replyTimer.Stop();
+    
+    const DpThemeReply reply{m_currentTheme, m_mode, authoritative};
+    m_replyPromise.set_value(reply);
+    
+    std::vector<ThemeReadyCallback> callbacks;
+    callbacks.swap(m_readyCallbacks);
+    for (auto& callback : callbacks) {
+        callback(reply);
+    }
+}
+
+void DpThemeClient::OnReplyTimeout(wxTimerEvent& WXUNUSED(event)) {
+    wxLogDebug("DpThemeClient: no theme reply, using configured theme %s", m_currentTheme);
+    ResolveReply(false);
+}
+
+namespace {
+    // Palette résolue d'un mode (variantes OKLab, quantification RGB565 éventuelle)
+    std::shared_ptr<const DpResolvedPalette> BuildResolvedPalette(const DpThemeProfile& profile, DpThemeMode mode,
+                                                                  const DpRgb565Palette* quantized) {
+        auto resolved = std::make_shared<DpResolvedPalette>();
+        if (quantized) {
+            resolved->Build(quantized->palette);
+            resolved->QuantizeRgb565();
+        } else {
+            resolved->Build(mode == DpThemeMode::Night ? profile.night : profile.day);
+        }
+        return resolved;
+    }
+    
+    using RawView = std::basic_string_view<wxStringCharType>;
+    
+    RawView ViewOf(const wxString& text) {
+        const wxStringCharType* data = text.wx_str();
+        return RawView(data, std::char_traits<wxStringCharType>::length(data));
+    }
+    
+    bool EqualsAscii(RawView view, std::string_view ascii) {
+        return view.size() == ascii.size() && std::equal(view.begin(), view.end(), ascii.begin(),
+            [](wxStringCharType a, char b) { return a == static_cast<wxStringCharType>(b); });
+    }
+    
+    // Membres "type", "theme" et "mode" d'un message, lus dans le texte brut sans allocation.
+    // Ne reconnaît qu'un objet sans échappement, dont ces membres de premier niveau sont des
+    // chaînes présentes une seule fois ; sinon false, et le message passe par wxJSONReader.
+    struct RawThemeMessage {
+        RawView type;
+        RawView theme;
+        RawView mode;
+    };
+    
+    bool ScanThemeMessage(RawView body, RawThemeMessage& out) {
+        const wxStringCharType* p = body.data();
+        const wxStringCharType* const end = p + body.size();
+        auto skipSpace = [&]() {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+        };
+        // Chaîne commençant en p (sur le guillemet ouvrant) ; p passe après le guillemet fermant
+        auto readString = [&](RawView& text) {
+            const wxStringCharType* begin = ++p;
+            while (p < end && *p != '"') {
+                if (*p == '\\') return false;
+                ++p;
+            }
+            if (p == end) return false;
+            text = RawView(begin, static_cast<size_t>(p - begin));
+            ++p;
+            return true;
+        };
+        
+        skipSpace();
+        if (p == end || *p != '{') return false;
+        
+        int depth = 0;
+        bool seen[3] = {false, false, false};
+        while (p < end) {
+            const wxStringCharType c = *p;
+            if (c == '"') {
+                RawView token;
+                if (!readString(token)) return false;
+                skipSpace();
+                if (depth != 1 || p == end || *p != ':') continue;  // Valeur, ou clé imbriquée
+                
+                ++p;
+                const int member = EqualsAscii(token, "type") ? 0 : EqualsAscii(token, "theme") ? 1
+                                 : EqualsAscii(token, "mode") ? 2 : -1;
+                if (member < 0) continue;
+                skipSpace();
+                if (seen[member] || p == end || *p != '"') return false;
+                seen[member] = true;
+                RawView& value = member == 0 ? out.type : member == 1 ? out.theme : out.mode;
+                if (!readString(value)) return false;
+            } else {
+                if (c == '\\') return false;
+                if (c == '{' || c == '[') ++depth;
+                if (c == '}' || c == ']') --depth;
+                ++p;
+            }
+        }
+        return depth == 0 && seen[0] && seen[1] && seen[2];
+    }
+    
+    // Premier usage de la palette par le plugin (instantané dans la trace de démarrage)
+    void TraceFirstPaletteUse() {
+        static DpTraceOnce firstUse;
+        if (firstUse.First()) {
+            DpTrace::Instance().AddInstant("DpThemeClient first palette use");
+        }
+    }
+}
+
+const wxColour& DpThemeClient::GetColor(DpColorRole role) const {
+    TraceFirstPaletteUse();
+    return m_resolved->Get(role);
+}
+
+const wxColour& DpThemeClient::GetColorVariant(DpColorRole role, DpColorVariant variant) const {
+    TraceFirstPaletteUse();
+    return m_resolved->Get(role, variant);
 }
 
 void DpThemeClient::HandleThemeMessage(const wxString& message_body) {
+    const int64_t receivedUs = DpNowMicros();
+    
+    // Rediffusion du thème et du mode courants, reconnue sans analyse JSON ni allocation :
+    // seule l'attente d'une première réponse est résolue
+    RawThemeMessage raw;
+    if (m_hasPalette && ScanThemeMessage(ViewOf(message_body), raw)
+        && (EqualsAscii(raw.type, "theme_current") || EqualsAscii(raw.type, "theme_changed"))
+        && raw.theme == ViewOf(m_currentTheme)
+        && (EqualsAscii(raw.mode, "night") ? DpThemeMode::Night : DpThemeMode::Day) == m_mode) {
+        ResolveReply(true);
+        return;
+    }
     
     wxJSONReader reader;
     wxJSONValue root;
@@ -62,31 +254,77 @@ void DpThemeClient::HandleThemeMessage(const wxString& message_body) {
         wxString themeName = root["theme"].AsString();
         wxString modeStr = root["mode"].AsString();
         
-       
-        
         DpThemeMode mode = (modeStr == "night") 
             ? DpThemeMode::Night 
             : DpThemeMode::Day;
         
-        ApplyTheme(themeName, mode);
+        // Rediffusion que le texte brut ne permettait pas de reconnaître (échappements...) :
+        // rien n'est appliqué, ni compté dans les latences
+        if (m_hasPalette && themeName == m_currentTheme && mode == m_mode) {
+            ResolveReply(true);
+            return;
+        }
+        
+        // Horodatages optionnels du propriétaire du thème
+        m_trace = ThemeTrace();
+        if (root.HasMember("change_id")) {
+            m_trace.changeId = static_cast<long>(root["change_id"].AsInt64());
+            m_trace.sentUs = root.HasMember("sent_us") ? root["sent_us"].AsInt64() : 0;
+            m_trace.receivedUs = receivedUs;
+            if (m_trace.sentUs > 0) {
+                m_latency.delivery.Record(receivedUs - m_trace.sentUs);
+            }
+        }
+        
+        const bool applied = ApplyTheme(themeName, mode);
+        m_trace = ThemeTrace();
+        
+        // Premier thème valide du plugin principal : fin d'une attente éventuelle.
+        // Un thème inconnu ne confirme rien, le délai de repli reste armé.
+        if (applied) {
+            ResolveReply(true);
+        }
+    } else if (type == "theme_stats_request") {
+        SendLatencyStats();
     }
 }
 
-void DpThemeClient::ApplyTheme(const wxString& themeName, DpThemeMode mode) {
+bool DpThemeClient::ApplyTheme(const wxString& themeName, DpThemeMode mode) {
     // Vérifier si le thème existe
     if (!DpThemeLibrary::ThemeExists(themeName)) {
-        return;
+        wxLogDebug("DpThemeClient: unknown theme %s ignored", themeName);
+        return false;
     }
     
     // Vérifier si c'est un changement
     bool changed = (m_currentTheme != themeName || m_mode != mode);
     
+    // Thème et mode courants : palette déjà résolue, ni recalcul, ni écriture de la
+    // config, ni notification, ni échantillon de latence (rien n'est appliqué)
+    if (!changed && m_hasPalette) {
+        return true;
+    }
+    
     // Mettre à jour l'état
     m_currentTheme = themeName;
     m_mode = mode;
     
-    // Charger le profil complet depuis la bibliothèque
-    m_cachedProfile = DpThemeLibrary::GetTheme(themeName);
+    // Thème préparé : simple échange de pointeurs
+    if (IsPrepared(themeName, mode)) {
+        BuildPreparedPalette();  // Sans effet si le calcul différé est déjà passé
+        m_cachedProfile = std::move(m_prepared.profile);
+        m_resolved = std::move(m_prepared.palette);
+        m_hasPalette = true;
+        m_prepared = PreparedTheme();
+    } else {
+        // Charger le profil complet depuis la bibliothèque
+        m_cachedProfile = std::make_shared<const DpThemeProfile>(DpThemeLibrary::GetTheme(themeName));
+        ResolvePalette();
+    }
+    
+    if (m_trace.receivedUs > 0) {
+        m_latency.apply.Record(DpNowMicros() - m_trace.receivedUs);
+    }
     
     // Sauvegarder dans la config
     SaveToConfig();
@@ -95,13 +333,73 @@ void DpThemeClient::ApplyTheme(const wxString& themeName, DpThemeMode mode) {
     if (changed) {
         NotifyThemeChange();
     }
+    return true;
 }
 
-void DpThemeClient::NotifyThemeChange() {
-  
+// Palette du mode courant, quantifiée si la sortie est en 16 bits
+void DpThemeClient::ResolvePalette() {
+    const DpRgb565Palette* quantized = m_outputFormat == DpOutputFormat::RGB565
+        ? DpThemeLibrary::GetRgb565Palette(m_currentTheme, m_mode)
+        : nullptr;
+    m_resolved = BuildResolvedPalette(*m_cachedProfile, m_mode, quantized);
+    m_hasPalette = true;
+}
+
+void DpThemeClient::PrepareMode(DpThemeMode mode) {
+    PrepareTheme(m_currentTheme, mode);
+}
+
+void DpThemeClient::PrepareTheme(const wxString& themeName) {
+    PrepareTheme(themeName, m_mode);
+}
+
+void DpThemeClient::PrepareTheme(const wxString& themeName, DpThemeMode mode) {
+    // Déjà actif, ou déjà préparé
+    if (themeName == m_currentTheme && mode == m_mode) return;
+    if (IsPrepared(themeName, mode)) return;
+    if (!DpThemeLibrary::ThemeExists(themeName)) return;
+    DpTraceScope trace("DpThemeClient::PrepareTheme");
+    
+    // Profil et palette RGB565 lus tout de suite ; le calcul des variantes est différé
+    // à la prochaine itération de la boucle d'événements, toujours sur le thread principal
+    m_prepared.theme = themeName;
+    m_prepared.mode = mode;
+    m_prepared.format = m_outputFormat;
+    m_prepared.profile = std::make_shared<const DpThemeProfile>(DpThemeLibrary::GetTheme(themeName));
+    m_prepared.quantized = m_outputFormat == DpOutputFormat::RGB565
+        ? DpThemeLibrary::GetRgb565Palette(themeName, mode)
+        : nullptr;
+    m_prepared.palette.reset();
+    CallAfter(&DpThemeClient::BuildPreparedPalette);
+}
+
+bool DpThemeClient::IsPrepared(const wxString& themeName, DpThemeMode mode) const {
+    return m_prepared.profile && m_prepared.theme == themeName && m_prepared.mode == mode
+        && m_prepared.format == m_outputFormat;
+}
+
+// Palette du thème préparé, si elle n'est pas déjà calculée (ou consommée par ApplyTheme)
+void DpThemeClient::BuildPreparedPalette() {
+    if (!m_prepared.profile || m_prepared.palette) return;
+    DpTraceScope trace("DpThemeClient::BuildPreparedPalette");
+    m_prepared.palette = BuildResolvedPalette(*m_prepared.profile, m_prepared.mode, m_prepared.quantized);
+}
+
+void DpThemeClient::SetOutputFormat(DpOutputFormat format) {
+    if (format == m_outputFormat) return;
     
-    // Appeler tous les callbacks enregistrés
-    for (auto& callback : m_changeCallbacks) {
+    m_outputFormat = format;
+    ResolvePalette();
+    NotifyThemeChange();
+}
+
+void DpThemeClient::NotifyThemeChange() {
+    // Appeler tous les callbacks enregistrés (repeint, horloge d'animation, icônes RGB565
+    // s'y abonnent). Un callback peut en enregistrer un autre : copie avant l'appel, et
+    // les nouveaux ne sont appelés qu'au changement suivant.
+    const size_t count = m_changeCallbacks.size();
+    for (size_t i = 0; i < count; ++i) {
+        const ThemeChangeCallback callback = m_changeCallbacks[i];
         if (callback) {
             callback();
         }
@@ -110,6 +408,36 @@ void DpThemeClient::NotifyThemeChange() {
     // Envoyer un événement wx
     wxCommandEvent event(EVT_DPTHEME_CHANGED);
     ProcessEvent(event);
+    
+    // Fin de la chaîne pour un changement horodaté
+    if (m_trace.receivedUs > 0) {
+        const int64_t notifiedUs = DpNowMicros();
+        m_latency.notify.Record(notifiedUs - m_trace.receivedUs);
+        if (m_trace.sentUs > 0) {
+            m_latency.endToEnd.Record(notifiedUs - m_trace.sentUs);
+        }
+        m_latency.lastChangeId = m_trace.changeId;
+    }
+}
+
+// Rapport des latences, à la demande du propriétaire du thème
+void DpThemeClient::SendLatencyStats() {
+    if (!m_initialized || !m_callbacks.sendMessage) return;
+    
+    wxJSONValue stats;
+    stats["type"] = "theme_stats";
+    stats["sender"] = m_pluginName;
+    stats["last_change_id"] = static_cast<wxInt64>(m_latency.lastChangeId);
+    m_latency.delivery.ToJSON(stats["delivery"]);
+    m_latency.apply.ToJSON(stats["apply"]);
+    m_latency.notify.ToJSON(stats["notify"]);
+    m_latency.endToEnd.ToJSON(stats["end_to_end"]);
+    
+    wxJSONWriter writer;
+    wxString jsonStr;
+    writer.Write(stats, jsonStr);
+    
+    m_callbacks.sendMessage("DPTHEME_STATS", jsonStr);
 }
 
 void DpThemeClient::RegisterCallback(ThemeChangeCallback callback) {
@@ -122,6 +450,7 @@ void DpThemeClient::ForceRefresh() {
 
 void DpThemeClient::LoadFromConfig() {
     if (!m_callbacks.getConfig) return;
+    DpTraceScope trace("DpThemeClient::LoadFromConfig");
     
     wxFileConfig* config = m_callbacks.getConfig();
     if (!config) return;
@@ -136,8 +465,10 @@ void DpThemeClient::LoadFromConfig() {
     config->SetPath(oldPath);
     
     // Charger le profil
+    m_hasPalette = false;
     if (DpThemeLibrary::ThemeExists(m_currentTheme)) {
-        m_cachedProfile = DpThemeLibrary::GetTheme(m_currentTheme);
+        m_cachedProfile = std::make_shared<const DpThemeProfile>(DpThemeLibrary::GetTheme(m_currentTheme));
+        ResolvePalette();
     }
 }
 
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "DpThemes.h"
+#include "DpColorVariants.h"
+#include "DpRgb565.h"
+#include "DpThemeLatency.h"
 #include <wx/string.h>
 #include <wx/event.h>
+#include <wx/timer.h>
 #include <functional>
+#include <future>
+#include <memory>
+#include <vector>
 
 // Forward declaration
 class wxFileConfig;
@@ -19,6 +26,15 @@ struct DpThemeClientCallbacks {
     std::function<wxFileConfig*()> getConfig;
 };
 
+/**
+ * @brief Thème connu à la fin d'une attente de RequestCurrentThemeAsync
+ */
+struct DpThemeReply {
+    wxString theme;
+    DpThemeMode mode = DpThemeMode::Day;
+    bool authoritative = false;  // false : délai dépassé, thème lu dans la config locale
+};
+
 /**
  * @brief Classe de base pour les clients de thème
  */
@@ -26,6 +42,7 @@ class DpThemeClient : public wxEvtHandler {
 public:
     // Type de callback pour les changements de thème
     using ThemeChangeCallback = std::function<void()>;
+    using ThemeReadyCallback = std::function<void(const DpThemeReply&)>;
     
     static DpThemeClient& Instance();
     
@@ -35,15 +52,47 @@ public:
     // Demande le thème actuel au plugin principal
     void RequestCurrentTheme();
     
-    // Récupère une couleur
-    wxColour GetColor(DpColorRole role) const;
+    // Version asynchrone : résolue au premier theme_current (ou theme_changed) dont le thème
+    // existe, ou après timeoutMs avec le thème de la config. Le callback est appelé sur le thread
+    // principal, une fois la palette appliquée ; immédiatement si le thème est déjà connu.
+    // Les messages arrivent sur le thread principal : n'y attendre jamais le future.
+    std::shared_future<DpThemeReply> RequestCurrentThemeAsync(int timeoutMs = 1000,
+                                                              ThemeReadyCallback callback = {});
+    bool IsThemeConfirmed() const { return m_themeConfirmed; }
+    
+    // Récupère une couleur (lecture dans la palette résolue, sans allocation ni copie)
+    const wxColour& GetColor(DpColorRole role) const;
+    
+    // Variante précalculée (survol, appui, focus, désactivé, transparences) du mode courant.
+    // Les références restent valides jusqu'au prochain changement de thème ou de format.
+    const wxColour& GetColorVariant(DpColorRole role, DpColorVariant variant) const;
+    const DpResolvedPalette& GetResolvedPalette() const { return *m_resolved; }
+    
+    // Pré-calcul de la palette d'un autre mode ou thème (ex. avant le crépuscule) : couleurs
+    // et variantes, quantifiées en sortie RGB565. Le calcul est fait sur le thread principal
+    // à la prochaine itération de la boucle d'événements ; le mode courant reste actif. Au
+    // changement, ApplyTheme échange alors la palette au lieu de la calculer ; la sauvegarde,
+    // les notifications et les repeints restent faits à ce moment. Rien d'autre n'est préparé :
+    // les masques d'icônes ne dépendent pas du thème, et les icônes RGB565 (par couleur et
+    // fond) sont converties au premier dessin qui suit. Un seul thème préparé à la fois : le
+    // dernier demandé.
+    void PrepareMode(DpThemeMode mode);
+    void PrepareTheme(const wxString& themeName);
+    void PrepareTheme(const wxString& themeName, DpThemeMode mode);
+    
+    // Format de sortie : en RGB565, couleurs et variantes sont quantifiées (et distinctes)
+    void SetOutputFormat(DpOutputFormat format);
+    DpOutputFormat GetOutputFormat() const { return m_outputFormat; }
     
     // Getters
-    wxString GetCurrentThemeName() const { return m_currentTheme; }
+    const wxString& GetCurrentThemeName() const { return m_currentTheme; }
     DpThemeMode GetMode() const { return m_mode; }
     bool IsInitialized() const { return m_initialized; }
     
-    // Gestion des messages JSON
+    // Gestion des messages JSON. Une rediffusion du thème et du mode courants (les
+    // horodatages change_id / sent_us diffèrent à chaque envoi) est reconnue dans le texte
+    // brut, sans analyse JSON ni allocation : rien n'est recalculé, écrit, notifié ni
+    // compté dans les latences
     void HandleThemeMessage(const wxString& message_body);
     
     // Enregistrer un callback pour les changements
@@ -52,27 +101,71 @@ public:
     // Forcer un refresh
     void ForceRefresh();
     
+    // Latences des changements de thème horodatés (change_id / sent_us dans le message)
+    const DpThemeLatencyStats& GetLatencyStats() const { return m_latency; }
+    void ResetLatencyStats() { m_latency.Reset(); }
+    
 protected:
-    DpThemeClient() = default;
-    virtual ~DpThemeClient() = default;
+    DpThemeClient();
+    virtual ~DpThemeClient();
     
 private:
     wxString m_pluginName;
     wxString m_currentTheme = "Ocean";
     DpThemeMode m_mode = DpThemeMode::Day;
+    DpOutputFormat m_outputFormat = DpOutputFormat::RGBA8888;
     bool m_initialized = false;
+    bool m_hasPalette = false;     // m_resolved correspond à m_currentTheme / m_mode
     
     // Callbacks vers OpenCPN
     DpThemeClientCallbacks m_callbacks;
     
     // Cache local des couleurs actuelles
-    DpThemeProfile m_cachedProfile;
+    std::shared_ptr<const DpThemeProfile> m_cachedProfile;
+    
+    // Palette du mode courant et ses variantes, remplacée à chaque changement
+    std::shared_ptr<const DpResolvedPalette> m_resolved;
+    
+    // Thème préparé par PrepareTheme (palette calculée par BuildPreparedPalette)
+    struct PreparedTheme {
+        wxString theme;
+        DpThemeMode mode = DpThemeMode::Day;
+        DpOutputFormat format = DpOutputFormat::RGBA8888;
+        std::shared_ptr<const DpThemeProfile> profile;
+        const DpRgb565Palette* quantized = nullptr;  // Sortie RGB565 uniquement
+        std::shared_ptr<const DpResolvedPalette> palette;  // nullptr tant que le calcul n'est pas passé
+    };
+    PreparedTheme m_prepared;
     
     // Callbacks enregistrés pour les changements
     std::vector<ThemeChangeCallback> m_changeCallbacks;
     
-    void ApplyTheme(const wxString& themeName, DpThemeMode mode);
+    // Traçage du changement en cours (horodatages en µs, 0 = absent)
+    struct ThemeTrace {
+        long changeId = -1;
+        int64_t sentUs = 0;
+        int64_t receivedUs = 0;
+    };
+    ThemeTrace m_trace;
+    DpThemeLatencyStats m_latency;
+    
+    // Attente du premier thème du plugin principal
+    bool m_themeConfirmed = false;
+    bool m_replyPending = false;
+    std::promise<DpThemeReply> m_replyPromise;
+    std::shared_future<DpThemeReply> m_replyFuture;
+    std::vector<ThemeReadyCallback> m_readyCallbacks;
+    wxTimer m_replyTimer;
+    
+    void ResolveReply(bool authoritative);
+    void OnReplyTimeout(wxTimerEvent& event);
+    // false si le thème est inconnu (rien n'est appliqué)
+    bool ApplyTheme(const wxString& themeName, DpThemeMode mode);
+    void ResolvePalette();
+    bool IsPrepared(const wxString& themeName, DpThemeMode mode) const;
+    void BuildPreparedPalette();
     void NotifyThemeChange();
+    void SendLatencyStats();
     void LoadFromConfig();
     void SaveToConfig();
 };
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "DpThemeLatency.h"
+#include <wx/jsonval.h>
+#include <algorithm>
+#include <chrono>
+
+int64_t DpNowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void DpStampThemeMessage(wxJSONValue& message, long changeId) {
+    message["change_id"] = static_cast<wxInt64>(changeId);
+    message["sent_us"] = static_cast<wxInt64>(DpNowMicros());
+}
+
+void DpLatencyHistogram::Record(int64_t micros) {
+    micros = std::max<int64_t>(micros, 0);
+
+    int bucket = 0;
+    while (bucket < kBucketCount - 1 && (int64_t(1) << bucket) <= micros) {
+        ++bucket;
+    }
+
+    ++m_buckets[bucket];
+    ++m_count;
+    m_sum += micros;
+    m_max = std::max(m_max, micros);
+}
+
+void DpLatencyHistogram::Merge(const DpLatencyHistogram& other) {
+    for (int i = 0; i < kBucketCount; ++i) {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_max = std::max(m_max, other.m_max);
+}
+
+void DpLatencyHistogram::Reset() {
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sum = 0;
+    m_max = 0;
+}
+
+int64_t DpLatencyHistogram::GetPercentileMicros(double p) const {
+    if (m_count == 0) return 0;
+
+    const double target = std::clamp(p, 0.0, 100.0) / 100.0 * m_count;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += m_buckets[i];
+        if (seen > 0 && seen >= target) {
+            return std::min(int64_t(1) << i, m_max);
+        }
+    }
+    return m_max;
+}
+
+void DpLatencyHistogram::ToJSON(wxJSONValue& out) const {
+    out["count"] = static_cast<wxInt64>(m_count);
+    out["mean_us"] = GetMeanMicros();
+    out["p50_us"] = static_cast<wxInt64>(GetPercentileMicros(50));
+    out["p99_us"] = static_cast<wxInt64>(GetPercentileMicros(99));
+    out["max_us"] = static_cast<wxInt64>(m_max);
+    for (uint32_t count : m_buckets) {
+        out["buckets"].Append(static_cast<int>(count));
+    }
+}
+
+void DpThemeLatencyStats::Reset() {
+    delivery.Reset();
+    apply.Reset();
+    notify.Reset();
+    endToEnd.Reset();
+    lastChangeId = -1;
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Forward declaration
+class wxJSONValue;
+
+// Horloge monotone en microsecondes. Tous les plugins partagent le processus
+// OpenCPN : les horodatages de l'émetteur et des clients sont comparables.
+int64_t DpNowMicros();
+
+// Ajoute un identifiant de changement et l'heure d'envoi à un message theme_changed
+// (côté propriétaire du thème, juste avant l'envoi)
+void DpStampThemeMessage(wxJSONValue& message, long changeId);
+
+/**
+ * @brief Histogramme de latences à seaux logarithmiques (puissances de 2, en µs)
+ */
+class DpLatencyHistogram {
+public:
+    static constexpr int kBucketCount = 25;  // Seau i : [2^(i-1), 2^i) µs ; le dernier est ouvert
+
+    void Record(int64_t micros);
+    void Merge(const DpLatencyHistogram& other);
+    void Reset();
+
+    uint64_t GetCount() const { return m_count; }
+    int64_t GetMax() const { return m_max; }
+    double GetMeanMicros() const { return m_count ? static_cast<double>(m_sum) / m_count : 0.0; }
+
+    // Borne haute du seau contenant le percentile p (0..100)
+    int64_t GetPercentileMicros(double p) const;
+
+    const std::array<uint32_t, kBucketCount>& GetBuckets() const { return m_buckets; }
+
+    // Sérialisation pour le rapport envoyé au propriétaire du thème
+    void ToJSON(wxJSONValue& out) const;
+
+private:
+    std::array<uint32_t, kBucketCount> m_buckets{};
+    uint64_t m_count = 0;
+    int64_t m_sum = 0;
+    int64_t m_max = 0;
+};
+
+/**
+ * @brief Latences d'un client de thème pour chaque étape d'un changement
+ */
+struct DpThemeLatencyStats {
+    DpLatencyHistogram delivery;  // Envoi -> réception (HandleThemeMessage)
+    DpLatencyHistogram apply;     // Réception -> thème appliqué (ApplyTheme)
+    DpLatencyHistogram notify;    // Réception -> fin de NotifyThemeChange
+    DpLatencyHistogram endToEnd;  // Envoi -> fin de NotifyThemeChange
+    long lastChangeId = -1;
+
+    void Reset();
+};
\ No newline at end of file
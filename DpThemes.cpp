@@ -1,9 +1,21 @@
 #include "DpThemes.h"
+#include "DpRgb565.h"
+#include "DpTrace.h"
+#include <wx/log.h>
+#include <array>
+
+namespace {
+    // Retournée par référence pour un rôle ou un thème absent
+    const wxColour& InvalidColour() {
+        static const wxColour invalid;
+        return invalid;
+    }
+}
 
 // Implémentation de DpPalette
-wxColour DpPalette::operator[](DpColorRole r) const {
+const wxColour& DpPalette::operator[](DpColorRole r) const {
     auto it = colors.find(r);
-    return (it != colors.end()) ? it->second : wxColour();
+    return (it != colors.end()) ? it->second : InvalidColour();
 }
 
 // Variables statiques
@@ -23,7 +35,7 @@ std::vector<DpThemeProfile> DpThemeLibrary::GetAllThemes() {
 }
 
 // Récupère un thème par son nom
-DpThemeProfile DpThemeLibrary::GetTheme(const wxString& name) {
+const DpThemeProfile& DpThemeLibrary::GetTheme(const wxString& name) {
     if (!initialized_) InitThemes();
     
     auto it = themes_.find(name);
@@ -53,19 +65,47 @@ bool DpThemeLibrary::ThemeExists(const wxString& name) {
 }
 
 // Récupère une couleur spécifique
-wxColour DpThemeLibrary::GetColor(const wxString& themeName, DpThemeMode mode, DpColorRole role) {
+const wxColour& DpThemeLibrary::GetColor(const wxString& themeName, DpThemeMode mode, DpColorRole role) {
     if (!initialized_) InitThemes();
     
     auto it = themes_.find(themeName);
     if (it != themes_.end()) {
         return (mode == DpThemeMode::Night) ? it->second.night[role] : it->second.day[role];
     }
-    return wxColour();
+    return InvalidColour();
+}
+
+// Palettes RGB565, quantifiées une fois pour tous les thèmes (sortie 16 bits uniquement)
+const DpRgb565Palette* DpThemeLibrary::GetRgb565Palette(const wxString& themeName, DpThemeMode mode) {
+    if (!initialized_) InitThemes();
+    
+    static std::unordered_map<wxString, std::array<DpRgb565Palette, 2>> palettes;
+    if (palettes.empty()) {
+        for (const auto& entry : themes_) {
+            std::array<DpRgb565Palette, 2>& quantized = palettes[entry.first];
+            quantized[0].Build(entry.second.day);
+            quantized[1].Build(entry.second.night);
+            
+            for (int m = 0; m < 2; ++m) {
+                for (const auto& pair : quantized[m].merged) {
+                    wxLogDebug("Theme %s (%s): roles %d and %d identical in RGB565", entry.first,
+                               m ? "night" : "day", static_cast<int>(pair.first), static_cast<int>(pair.second));
+                }
+            }
+        }
+    }
+    
+    auto it = palettes.find(themeName);
+    if (it == palettes.end()) {
+        return nullptr;
+    }
+    return &it->second[mode == DpThemeMode::Night ? 1 : 0];
 }
 
 // Initialisation des thèmes
 void DpThemeLibrary::InitThemes() {
     if (initialized_) return;
+    DpTraceScope trace("DpThemeLibrary::InitThemes");
     
     /* ========== THÈME DARK ========== */
     DpThemeProfile dark;
@@ -36,6 +36,12 @@ enum class DpColorRole {
     HighlightDisabled
 };
 
+// Nombre de rôles (à maintenir avec la dernière valeur)
+constexpr int DpColorRoleCount = static_cast<int>(DpColorRole::HighlightDisabled) + 1;
+
+// Palette quantifiée RGB565 (voir DpRgb565.h)
+struct DpRgb565Palette;
+
 // Mode jour/nuit
 enum class DpThemeMode { 
     Day, 
@@ -45,7 +51,7 @@ enum class DpThemeMode {
 // Palette de couleurs
 struct DpPalette {
     std::unordered_map<DpColorRole, wxColour> colors;
-    wxColour operator[](DpColorRole r) const;
+    const wxColour& operator[](DpColorRole r) const;  // Couleur invalide si le rôle manque
 };
 
 // Profil de thème complet
@@ -68,8 +74,8 @@ public:
     // Récupère tous les thèmes disponibles
     static std::vector<DpThemeProfile> GetAllThemes();
     
-    // Récupère un thème par son nom
-    static DpThemeProfile GetTheme(const wxString& name);
+    // Récupère un thème par son nom (référence stable, sans copie du profil)
+    static const DpThemeProfile& GetTheme(const wxString& name);
     
     // Récupère la liste des noms de thèmes
     static std::vector<wxString> GetThemeNames();
@@ -78,7 +84,10 @@ public:
     static bool ThemeExists(const wxString& name);
     
     // Récupère une couleur spécifique
-    static wxColour GetColor(const wxString& themeName, DpThemeMode mode, DpColorRole role);
+    static const wxColour& GetColor(const wxString& themeName, DpThemeMode mode, DpColorRole role);
+    
+    // Palette RGB565 d'un thème ; celles de tous les thèmes et modes sont calculées au premier appel
+    static const DpRgb565Palette* GetRgb565Palette(const wxString& themeName, DpThemeMode mode);
     
 private:
     // Initialise les thèmes au premier appel
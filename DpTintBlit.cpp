@@ -0,0 +1,140 @@
+#include "DpTintBlit.h"
+#include <wx/image.h>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DP_TINT_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DP_TINT_NEON 1
+#endif
+
+namespace {
+    constexpr int kChunkPixels = 16;  // Pixels développés par passe (64 octets en RGBA)
+
+    // (dst * (255 - a) + c * a) / 255, arrondi exact : t = x + 128 ; (t + (t >> 8)) >> 8
+    inline uint8_t BlendByte(uint8_t dst, uint8_t colour, uint8_t alpha) {
+        const unsigned t = dst * (255u - alpha) + colour * alpha + 128u;
+        return static_cast<uint8_t>((t + (t >> 8)) >> 8);
+    }
+
+#if DP_TINT_SSE2
+    // Les deux produits pondèrent à 255 au total : la somme tient dans 16 bits non signés
+    inline __m128i Blend8x16(__m128i dst, __m128i colour, __m128i alpha) {
+        const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(dst, inv), _mm_mullo_epi16(colour, alpha));
+        t = _mm_add_epi16(t, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+#endif
+
+    // dst[i] = mélange de dst[i] vers colour[i] selon alpha[i]
+    void BlendBytes(uint8_t* dst, const uint8_t* colour, const uint8_t* alpha, size_t n) {
+        size_t i = 0;
+#if DP_TINT_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= n; i += 16) {
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colour + i));
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alpha + i));
+            const __m128i lo = Blend8x16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(a, zero));
+            const __m128i hi = Blend8x16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(a, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+        }
+#elif DP_TINT_NEON
+        for (; i + 8 <= n; i += 8) {
+            const uint8x8_t d = vld1_u8(dst + i);
+            const uint8x8_t c = vld1_u8(colour + i);
+            const uint8x8_t a = vld1_u8(alpha + i);
+            uint16x8_t t = vmlal_u8(vmull_u8(d, vsub_u8(vdup_n_u8(255), a)), c, a);
+            t = vaddq_u16(t, vdupq_n_u16(128));
+            vst1_u8(dst + i, vshrn_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8));
+        }
+#endif
+        for (; i < n; ++i) {
+            dst[i] = BlendByte(dst[i], colour[i], alpha[i]);
+        }
+    }
+
+    // Couverture du masque pondérée par l'alpha de la couleur
+    struct AlphaTable {
+        uint8_t values[256];
+
+        explicit AlphaTable(uint8_t colourAlpha) {
+            for (int m = 0; m < 256; ++m) {
+                values[m] = BlendByte(0, static_cast<uint8_t>(m), colourAlpha);
+            }
+        }
+    };
+
+    // Zone commune du masque placé en (x, y) et de la destination
+    bool Clip(int dstWidth, int dstHeight, int x, int y, const DpGlyphBitmap& mask,
+              int& x0, int& y0, int& x1, int& y1) {
+        x0 = std::max(0, -x);
+        y0 = std::max(0, -y);
+        x1 = std::min(mask.width, dstWidth - x);
+        y1 = std::min(mask.height, dstHeight - y);
+        return x0 < x1 && y0 < y1 && !mask.alpha.empty();
+    }
+
+    // Ligne de masque -> couleur et alpha par octet, par paquets de kChunkPixels
+    template <int Channels>
+    void TintRow(uint8_t* dst, const uint8_t* mask, int count, const uint8_t (&pattern)[Channels],
+                 const AlphaTable& table) {
+        uint8_t colour[kChunkPixels * Channels];
+        for (int p = 0; p < kChunkPixels; ++p) {
+            std::copy(pattern, pattern + Channels, colour + p * Channels);
+        }
+
+        uint8_t alpha[kChunkPixels * Channels];
+        for (int start = 0; start < count; start += kChunkPixels) {
+            const int n = std::min(kChunkPixels, count - start);
+            bool any = false;
+            for (int p = 0; p < n; ++p) {
+                const uint8_t a = table.values[mask[start + p]];
+                any |= (a != 0);
+                std::fill(alpha + p * Channels, alpha + (p + 1) * Channels, a);
+            }
+            if (any) {
+                BlendBytes(dst + static_cast<size_t>(start) * Channels, colour, alpha,
+                           static_cast<size_t>(n) * Channels);
+            }
+        }
+    }
+}
+
+void DpTintBlitRGBA(uint8_t* dst, int dstWidth, int dstHeight, int dstStride,
+                    int x, int y, const DpGlyphBitmap& mask, const wxColour& colour) {
+    int x0, y0, x1, y1;
+    if (!dst || !Clip(dstWidth, dstHeight, x, y, mask, x0, y0, x1, y1)) return;
+
+    // Alpha cible 255 : source-over prémultiplié, a' = a + dstA * (1 - a)
+    const AlphaTable table(colour.Alpha());
+    const uint8_t pattern[4] = {colour.Red(), colour.Green(), colour.Blue(), 255};
+    for (int row = y0; row < y1; ++row) {
+        uint8_t* line = dst + static_cast<size_t>(y + row) * dstStride + static_cast<size_t>(x + x0) * 4;
+        TintRow<4>(line, mask.alpha.data() + static_cast<size_t>(row) * mask.width + x0, x1 - x0, pattern, table);
+    }
+}
+
+void DpTintBlit(wxImage& image, int x, int y, const DpGlyphBitmap& mask, const wxColour& colour) {
+    int x0, y0, x1, y1;
+    if (!image.IsOk() || !Clip(image.GetWidth(), image.GetHeight(), x, y, mask, x0, y0, x1, y1)) return;
+
+    const AlphaTable table(colour.Alpha());
+    const uint8_t rgb[3] = {colour.Red(), colour.Green(), colour.Blue()};
+    const uint8_t opaque[1] = {255};
+    unsigned char* data = image.GetData();
+    unsigned char* alpha = image.HasAlpha() ? image.GetAlpha() : nullptr;
+    const int width = image.GetWidth();
+
+    for (int row = y0; row < y1; ++row) {
+        const size_t offset = static_cast<size_t>(y + row) * width + (x + x0);
+        const uint8_t* maskLine = mask.alpha.data() + static_cast<size_t>(row) * mask.width + x0;
+        TintRow<3>(data + offset * 3, maskLine, x1 - x0, rgb, table);
+        if (alpha) {
+            TintRow<1>(alpha + offset, maskLine, x1 - x0, opaque, table);
+        }
+    }
+}
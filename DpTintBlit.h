@@ -0,0 +1,21 @@
+#pragma once
+
+#include "DpIconAtlas.h"
+#include <cstdint>
+#include <wx/colour.h>
+
+class wxImage;
+
+/*
+ * Teinte au moment du dessin : un masque de couverture 8 bits est composé
+ * directement sur la destination avec la couleur voulue (source-over), sans
+ * bitmap intermédiaire par couleur. Le mélange est fait en SSE2 ou NEON si
+ * disponibles, avec une division par 255 exacte (arrondie).
+ */
+
+// Destination RGBA8888 prémultipliée (ou opaque) : résultat exact ; stride en octets
+void DpTintBlitRGBA(uint8_t* dst, int dstWidth, int dstHeight, int dstStride,
+                    int x, int y, const DpGlyphBitmap& mask, const wxColour& colour);
+
+// wxImage : plan RGB, et plan alpha s'il existe (les pixels opaques sont exacts)
+void DpTintBlit(wxImage& image, int x, int y, const DpGlyphBitmap& mask, const wxColour& colour);
@@ -0,0 +1,95 @@
+#include "DpTrace.h"
+#include "DpThemeLatency.h"
+#include "DpThemes.h"
+#include <wx/utils.h>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+DpTrace& DpTrace::Instance() {
+    static DpTrace instance;
+    return instance;
+}
+
+DpTrace::DpTrace() {
+    if (const char* path = std::getenv("DPTHEME_TRACE")) {
+        if (*path) {
+            Enable(wxString::FromUTF8(path));
+        }
+    }
+}
+
+DpTrace::~DpTrace() {
+    Flush();
+}
+
+void DpTrace::Enable(const wxString& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_path = path;
+    m_events.reserve(256);
+    m_enabled.store(!path.IsEmpty(), std::memory_order_relaxed);
+}
+
+void DpTrace::Add(const Event& event) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_events.size() < kMaxEvents) {
+        m_events.push_back(event);
+    }
+}
+
+void DpTrace::AddSpan(const char* name, int64_t beginUs, int64_t durationUs) {
+    if (!IsEnabled()) return;
+    const uint32_t tid = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    Add({name, 'X', beginUs, durationUs, tid});
+}
+
+void DpTrace::AddInstant(const char* name) {
+    if (!IsEnabled()) return;
+    const uint32_t tid = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    Add({name, 'i', DpNowMicros(), 0, tid});
+}
+
+// Écriture en stdio : Flush() peut être appelé à la sortie, après l'arrêt de wxWidgets
+bool DpTrace::Flush() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_enabled.load(std::memory_order_relaxed) || m_path.IsEmpty()) {
+        return false;
+    }
+
+    FILE* file = std::fopen(m_path.utf8_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    const unsigned long pid = wxGetProcessId();
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%lu,\"tid\":0,\"args\":{\"name\":\"DpThemes\"}}",
+                 pid);
+    for (const Event& event : m_events) {
+        std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"startup\",\"ph\":\"%c\",\"ts\":%lld,\"pid\":%lu,\"tid\":%u",
+                     event.name, event.phase, static_cast<long long>(event.beginUs), pid, event.threadId);
+        if (event.phase == 'X') {
+            std::fprintf(file, ",\"dur\":%lld}", static_cast<long long>(event.durationUs));
+        } else {
+            std::fprintf(file, ",\"s\":\"p\"}");
+        }
+    }
+    std::fprintf(file, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"version\":\"%d.%d.%d\"}}\n",
+                 DpThemes::VERSION_MAJOR, DpThemes::VERSION_MINOR, DpThemes::VERSION_PATCH);
+
+    return std::fclose(file) == 0;
+}
+
+DpTraceScope::DpTraceScope(const char* name, bool active)
+    : m_name(name) {
+    if (active && DpTrace::Instance().IsEnabled()) {
+        m_beginUs = DpNowMicros();
+    }
+}
+
+DpTraceScope::~DpTraceScope() {
+    if (m_beginUs >= 0) {
+        DpTrace::Instance().AddSpan(m_name, m_beginUs, DpNowMicros() - m_beginUs);
+    }
+}
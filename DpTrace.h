@@ -0,0 +1,85 @@
+#pragma once
+
+#include <wx/string.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Traçage optionnel du démarrage, au format Chrome trace-event (chrome://tracing, Perfetto)
+ *
+ * Désactivé par défaut. Activé par la variable d'environnement DPTHEME_TRACE
+ * (chemin du fichier JSON) avant le chargement du plugin, ou par Enable().
+ * Le fichier est écrit par Flush() et à la fermeture du processus.
+ */
+class DpTrace {
+public:
+    static DpTrace& Instance();
+
+    void Enable(const wxString& path);
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    // Événement complet ("X") : début et durée en µs (horloge DpNowMicros)
+    void AddSpan(const char* name, int64_t beginUs, int64_t durationUs);
+
+    // Événement instantané ("i")
+    void AddInstant(const char* name);
+
+    // Écrit tous les événements enregistrés
+    bool Flush();
+
+private:
+    DpTrace();
+    ~DpTrace();
+
+    // Non copiable
+    DpTrace(const DpTrace&) = delete;
+    DpTrace& operator=(const DpTrace&) = delete;
+
+    struct Event {
+        const char* name;  // Littéral : aucune allocation à l'enregistrement
+        char phase;
+        int64_t beginUs;
+        int64_t durationUs;
+        uint32_t threadId;
+    };
+
+    static constexpr size_t kMaxEvents = 10000;
+
+    std::atomic<bool> m_enabled{false};
+    std::mutex m_mutex;
+    wxString m_path;
+    std::vector<Event> m_events;
+
+    void Add(const Event& event);
+};
+
+/**
+ * @brief Mesure la portée courante (rien n'est fait si le traçage est désactivé)
+ */
+class DpTraceScope {
+public:
+    explicit DpTraceScope(const char* name, bool active = true);
+    ~DpTraceScope();
+
+    DpTraceScope(const DpTraceScope&) = delete;
+    DpTraceScope& operator=(const DpTraceScope&) = delete;
+
+private:
+    const char* m_name;
+    int64_t m_beginUs = -1;  // -1 : inactif
+};
+
+/**
+ * @brief Vrai au premier appel seulement (premier rendu, premier usage de la palette)
+ */
+class DpTraceOnce {
+public:
+    bool First() {
+        return !m_done.load(std::memory_order_relaxed) && !m_done.exchange(true);
+    }
+
+private:
+    std::atomic<bool> m_done{false};
+};
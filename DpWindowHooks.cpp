@@ -0,0 +1,44 @@
+#include "DpWindowHooks.h"
+#include <wx/window.h>
+
+void DpWindowHooks::HookWindow(wxWindow* window) {
+    if (m_flags & HookShow) {
+        window->Bind(wxEVT_SHOW, &DpWindowHooks::OnShow, this);
+    }
+    if (m_flags & HookPaint) {
+        window->Bind(wxEVT_PAINT, &DpWindowHooks::OnPaint, this);
+    }
+    window->Bind(wxEVT_DESTROY, &DpWindowHooks::OnDestroy, this);
+}
+
+void DpWindowHooks::UnhookWindow(wxWindow* window) {
+    if (m_flags & HookShow) {
+        window->Unbind(wxEVT_SHOW, &DpWindowHooks::OnShow, this);
+    }
+    if (m_flags & HookPaint) {
+        window->Unbind(wxEVT_PAINT, &DpWindowHooks::OnPaint, this);
+    }
+    window->Unbind(wxEVT_DESTROY, &DpWindowHooks::OnDestroy, this);
+}
+
+void DpWindowHooks::OnPaint(wxPaintEvent& event) {
+    event.Skip();
+    OnWindowPaint(wxDynamicCast(event.GetEventObject(), wxWindow));
+}
+
+void DpWindowHooks::OnShow(wxShowEvent& event) {
+    event.Skip();
+    if (event.IsShown()) {
+        OnWindowShown(wxDynamicCast(event.GetEventObject(), wxWindow));
+    }
+}
+
+void DpWindowHooks::OnDestroy(wxWindowDestroyEvent& event) {
+    event.Skip();
+
+    // wxEVT_DESTROY d'un enfant remonte aussi ici : filtré par IsHooked
+    wxWindow* window = event.GetWindow();
+    if (window && IsHooked(window)) {
+        OnWindowDestroyed(window);
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <wx/event.h>
+
+// Forward declaration
+class wxWindow;
+class wxShowEvent;
+class wxPaintEvent;
+class wxWindowDestroyEvent;
+
+/**
+ * @brief Base des services qui suivent des fenêtres enregistrées
+ *
+ * Lie une fois par fenêtre les gestionnaires demandés (wxEVT_PAINT, wxEVT_SHOW) et
+ * wxEVT_DESTROY, et les délie au retrait. La classe dérivée tient sa propre liste :
+ * IsHooked() indique si une fenêtre y figure encore.
+ */
+class DpWindowHooks : public wxEvtHandler {
+protected:
+    enum HookFlags {
+        HookPaint = 1,
+        HookShow = 2
+    };
+
+    explicit DpWindowHooks(int flags) : m_flags(flags) {}
+
+    void HookWindow(wxWindow* window);
+    void UnhookWindow(wxWindow* window);
+
+    virtual bool IsHooked(wxWindow* window) const = 0;
+
+    // Appelé seulement pour une fenêtre suivie, jamais pour ses enfants
+    virtual void OnWindowDestroyed(wxWindow* window) = 0;
+
+    // Événements déjà propagés (Skip) au gestionnaire de la fenêtre
+    virtual void OnWindowPaint(wxWindow* WXUNUSED(window)) {}
+    virtual void OnWindowShown(wxWindow* WXUNUSED(window)) {}
+
+private:
+    int m_flags;
+
+    void OnPaint(wxPaintEvent& event);
+    void OnShow(wxShowEvent& event);
+    void OnDestroy(wxWindowDestroyEvent& event);
+};
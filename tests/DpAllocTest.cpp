@@ -0,0 +1,171 @@
+/**
+ * Compte les allocations de chaque accesseur en régime établi (GetColor,
+ * GetColorVariant, DpThemeLibrary::GetColor, GetIconGlyph) et d'une rediffusion
+ * du thème courant par HandleThemeMessage ; chacun doit n'en faire aucune.
+ * Vérifie aussi qu'une rediffusion ne déclenche ni recalcul ni notification.
+ *
+ *   dp_alloc_test [dossier du plugin]
+ *
+ * Le dossier du plugin contient data/resources (fichiers OTF) : sans lui, les faces
+ * d'icônes ne sont pas ouvertes et GetIconGlyph ne lit que les points de code
+ * nominaux. Cible dp_alloc_test de tests/CMakeLists.txt (wxWidgets et wxJSON requis),
+ * lancée par ctest sur une copie de resources/. Code de retour non nul en cas d'échec.
+ */
+#include "DpIcons.h"
+#include "DpThemeClient.h"
+#include "DpThemes.h"
+#include <wx/init.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+    std::atomic<bool> g_counting{false};
+    std::atomic<size_t> g_allocations{0};
+
+    void* CountedAlloc(size_t size) {
+        if (g_counting.load(std::memory_order_relaxed)) {
+            g_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (void* p = std::malloc(size ? size : 1)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what) {
+        std::printf("%s %s\n", condition ? "ok  " : "FAIL", what);
+        if (!condition) {
+            ++g_failures;
+        }
+    }
+
+    template <typename Body>
+    size_t CountAllocations(int calls, Body&& body) {
+        g_allocations = 0;
+        g_counting = true;
+        for (int i = 0; i < calls; ++i) {
+            body(i);
+        }
+        g_counting = false;
+        return g_allocations.load();
+    }
+
+    // Allocations de calls appels à body(i), après un premier passage hors comptage
+    // (statiques locales, résolutions au premier usage) ; rapportées par appel
+    template <typename Body>
+    void CheckNoAllocation(const char* name, int calls, Body&& body) {
+        for (int i = 0; i < calls; ++i) {
+            body(i);
+        }
+
+        const size_t allocations = CountAllocations(calls, body);
+        std::printf("     %-34s %zu allocations / %d calls (%.3f per call)\n", name, allocations, calls,
+                    static_cast<double>(allocations) / calls);
+        Check(allocations == 0, name);
+    }
+
+    // Client instanciable (le constructeur de DpThemeClient est protégé) ; aucun
+    // service du processus n'y est abonné
+    class TestClient : public DpThemeClient {
+    public:
+        TestClient() = default;
+    };
+
+    wxString ThemeMessage(const wxString& theme, const char* mode, long changeId) {
+        return wxString::Format("{\"type\":\"theme_changed\",\"theme\":\"%s\",\"mode\":\"%s\","
+                                "\"change_id\":%ld,\"sent_us\":%ld}", theme, mode, changeId, 1000 + changeId);
+    }
+}
+
+void* operator new(size_t size) { return CountedAlloc(size); }
+void* operator new[](size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    wxInitializer initializer;
+    if (!initializer.IsOk()) {
+        std::fprintf(stderr, "wxWidgets initialization failed\n");
+        return 2;
+    }
+
+    DpIconManager& icons = DpIconManager::Instance();
+    const bool haveFonts = argc > 1;
+    if (haveFonts) {
+        const wxString dataPath = wxString::FromUTF8(argv[1]);
+        DpIconCallbacks iconCallbacks;
+        iconCallbacks.getDataPath = [dataPath]() { return dataPath; };
+        icons.Init(iconCallbacks);
+    } else {
+        std::printf("     no plugin directory: icon faces are not loaded\n");
+    }
+
+    TestClient client;
+    int notifications = 0;
+    client.RegisterCallback([&notifications]() { ++notifications; });
+
+    DpThemeClientCallbacks callbacks;
+    callbacks.sendMessage = [](const wxString&, const wxString&) {};
+    client.Init("DpAllocTest", callbacks);
+
+    const wxString theme = "Ocean";
+    client.HandleThemeMessage(ThemeMessage(theme, "night", 1));
+    Check(client.GetCurrentThemeName() == theme && client.GetMode() == DpThemeMode::Night, "theme applied");
+
+    // Accesseurs, un appel par rôle (ou par icône et style)
+    unsigned sink = 0;
+    CheckNoAllocation("DpThemeClient::GetColor", DpColorRoleCount * 100, [&](int i) {
+        sink += client.GetColor(static_cast<DpColorRole>(i % DpColorRoleCount)).Red();
+    });
+    CheckNoAllocation("DpThemeClient::GetColorVariant", DpColorRoleCount * DpColorVariantCount * 10, [&](int i) {
+        const DpColorRole role = static_cast<DpColorRole>(i % DpColorRoleCount);
+        const DpColorVariant variant = static_cast<DpColorVariant>((i / DpColorRoleCount) % DpColorVariantCount);
+        sink += client.GetColorVariant(role, variant).Green();
+    });
+    CheckNoAllocation("DpThemeLibrary::GetColor", DpColorRoleCount * 100, [&](int i) {
+        const DpThemeMode mode = (i & 1) ? DpThemeMode::Night : DpThemeMode::Day;
+        sink += DpThemeLibrary::GetColor(theme, mode, static_cast<DpColorRole>(i % DpColorRoleCount)).Blue();
+    });
+    CheckNoAllocation("DpIconManager::GetIconGlyph", DpIconCount * 2 * 50, [&](int i) {
+        const DpIconStyle style = (i / DpIconCount) % 2 ? DpIconStyle::Regular : DpIconStyle::Solid;
+        sink += static_cast<unsigned>(icons.GetIconGlyph(static_cast<DpIcon>(i % DpIconCount), style).length());
+    });
+    if (haveFonts) {
+        Check(icons.HasGlyph(icons.GetIconCodepoint(DpIcon::Mark, DpIconStyle::Solid), DpIconStyle::Solid)
+              && icons.HasGlyph(icons.GetIconCodepoint(DpIcon::Mark, DpIconStyle::Regular), DpIconStyle::Regular),
+              "icon faces loaded and resolved");
+    }
+
+    // Rediffusions horodatées : même (thème, mode), corps différent à chaque fois.
+    // Les corps sont construits avant le comptage (ils arrivent tout faits d'OpenCPN).
+    const int rebroadcasts = 200;
+    std::vector<wxString> bodies;
+    for (int i = 0; i < rebroadcasts; ++i) {
+        bodies.push_back(ThemeMessage(theme, "night", 2 + i));
+    }
+    const DpResolvedPalette* palette = &client.GetResolvedPalette();
+    const int before = notifications;
+    CheckNoAllocation("HandleThemeMessage (rebroadcast)", rebroadcasts, [&](int i) {
+        client.HandleThemeMessage(bodies[i]);
+    });
+    Check(notifications == before, "rebroadcasts do not notify");
+    Check(&client.GetResolvedPalette() == palette, "rebroadcasts keep the resolved palette");
+    Check(client.GetLatencyStats().apply.GetCount() == 1, "rebroadcasts record no apply latency");
+
+    // Témoin : un vrai changement passe par wxJSONReader et alloue (le compteur est actif)
+    const wxString change = ThemeMessage(theme, "day", 1000);
+    const size_t changeAllocations = CountAllocations(1, [&](int) { client.HandleThemeMessage(change); });
+    std::printf("     %-34s %zu allocations / 1 call\n", "HandleThemeMessage (mode change)", changeAllocations);
+    Check(changeAllocations > 0, "counter sees the full parse of a change");
+    Check(notifications == before + 1 && client.GetMode() == DpThemeMode::Day, "mode change still applies");
+
+    std::printf("     checksum %u\n", sink);
+    return g_failures == 0 ? 0 : 1;
+}
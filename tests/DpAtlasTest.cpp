@@ -0,0 +1,188 @@
+/**
+ * Vérifie sans affichage le packer skyline et la construction de l'atlas d'icônes :
+ * rectangles dans les bornes et disjoints, pixels recopiés, UV et niveaux de mip.
+ *
+ * Sans dépendance à wxWidgets (voir tests/CMakeLists.txt, cible dp_atlas_test).
+ * Code de retour non nul en cas d'échec.
+ */
+#include "DpIconAtlas.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+    int g_failures = 0;
+
+    void Check(bool condition, const char* what) {
+        std::printf("%s %s\n", condition ? "ok  " : "FAIL", what);
+        if (!condition) {
+            ++g_failures;
+        }
+    }
+
+    bool Overlaps(const DpAtlasRect& a, const DpAtlasRect& b, int gap = 0) {
+        return a.x < b.x + b.width + gap && b.x < a.x + a.width + gap
+            && a.y < b.y + b.height + gap && b.y < a.y + a.height + gap;
+    }
+
+    bool InBounds(const DpAtlasRect& r, int width, int height) {
+        return r.x >= 0 && r.y >= 0 && r.x + r.width <= width && r.y + r.height <= height;
+    }
+
+    bool AllDisjoint(const std::vector<DpAtlasRect>& rects, int gap) {
+        for (size_t a = 0; a < rects.size(); ++a) {
+            for (size_t b = a + 1; b < rects.size(); ++b) {
+                if (Overlaps(rects[a], rects[b], gap)) return false;
+            }
+        }
+        return true;
+    }
+
+    // Couverture synthétique, jamais nulle dans le glyphe
+    uint8_t Coverage(int icon, int x, int y) {
+        return static_cast<uint8_t>(1 + (icon * 37 + x * 11 + y * 7) % 255);
+    }
+
+    std::vector<DpGlyphBitmap> SyntheticGlyphs() {
+        std::vector<DpGlyphBitmap> glyphs(DpIconCount);
+        for (int i = 0; i < DpIconCount; ++i) {
+            DpGlyphBitmap& g = glyphs[i];
+            g.width = 5 + i % 7;
+            g.height = 6 + i % 5;
+            g.alpha.resize(static_cast<size_t>(g.width) * g.height);
+            for (int y = 0; y < g.height; ++y) {
+                for (int x = 0; x < g.width; ++x) {
+                    g.alpha[static_cast<size_t>(y) * g.width + x] = Coverage(i, x, y);
+                }
+            }
+        }
+        return glyphs;
+    }
+
+    void TestPacker() {
+        DpSkylinePacker packer(64, 64);
+        const int sizes[][2] = {{20, 10}, {10, 20}, {30, 30}, {16, 16}, {8, 40}, {40, 8}, {12, 12}, {5, 5}, {64, 4}};
+        std::vector<DpAtlasRect> rects;
+        bool inserted = true;
+        bool bounded = true;
+        bool sized = true;
+        for (const auto& size : sizes) {
+            DpAtlasRect rect;
+            inserted = packer.Insert(size[0], size[1], rect) && inserted;
+            bounded = InBounds(rect, packer.GetWidth(), packer.GetHeight()) && bounded;
+            sized = rect.width == size[0] && rect.height == size[1] && sized;
+            rects.push_back(rect);
+        }
+        Check(inserted, "packer: known rectangles fit in 64x64");
+        Check(bounded, "packer: rectangles stay in bounds");
+        Check(sized, "packer: rectangles keep their size");
+        Check(AllDisjoint(rects, 0), "packer: rectangles do not overlap");
+
+        DpAtlasRect rect;
+        Check(!packer.Insert(65, 1, rect), "packer: wider than the area is rejected");
+        Check(!packer.Insert(64, 64, rect), "packer: no room left is rejected");
+    }
+
+    void TestBuild(DpAtlasFormat format, const char* name) {
+        const std::vector<DpGlyphBitmap> glyphs = SyntheticGlyphs();
+        const int maxLevels = 3;
+        DpIconAtlas atlas;
+        std::printf("---- %s\n", name);
+        Check(DpIconAtlas::Build(glyphs, format, maxLevels, atlas), "build succeeds");
+        if (atlas.levels.empty()) return;
+
+        const DpAtlasMipLevel& base = atlas.levels[0];
+        const int bpp = atlas.BytesPerPixel();
+        Check(base.width > 0 && (base.width & (base.width - 1)) == 0
+              && base.height > 0 && (base.height & (base.height - 1)) == 0, "level 0 is power of two");
+        Check(base.pixels.size() == static_cast<size_t>(base.width) * base.height * bpp, "level 0 buffer size");
+
+        // Rectangles : taille des glyphes, dans les bornes, séparés d'un pixel par niveau réduit
+        std::vector<DpAtlasRect> rects(atlas.rects.begin(), atlas.rects.end());
+        bool sized = true;
+        bool bounded = true;
+        for (int i = 0; i < DpIconCount; ++i) {
+            sized = rects[i].width == glyphs[i].width && rects[i].height == glyphs[i].height && sized;
+            bounded = InBounds(rects[i], base.width, base.height) && bounded;
+        }
+        Check(sized, "rects match glyph sizes");
+        Check(bounded, "rects stay in bounds");
+        Check(AllDisjoint(rects, 1 << (maxLevels - 1)), "rects keep a gap for every mip level");
+
+        // UV = rectangle / taille de l'atlas
+        bool uvOk = true;
+        for (int i = 0; i < DpIconCount; ++i) {
+            const DpAtlasRect& r = atlas.GetRect(static_cast<DpIcon>(i));
+            const DpAtlasUV& uv = atlas.GetUV(static_cast<DpIcon>(i));
+            uvOk = std::fabs(uv.u0 - static_cast<float>(r.x) / base.width) < 1e-6f
+                && std::fabs(uv.v0 - static_cast<float>(r.y) / base.height) < 1e-6f
+                && std::fabs(uv.u1 - static_cast<float>(r.x + r.width) / base.width) < 1e-6f
+                && std::fabs(uv.v1 - static_cast<float>(r.y + r.height) / base.height) < 1e-6f
+                && uvOk;
+        }
+        Check(uvOk, "UVs match rects");
+
+        // Pixels : couverture recopiée (blanc prémultiplié en RGBA), zéro hors des glyphes
+        std::vector<uint8_t> expected(base.pixels.size(), 0);
+        for (int i = 0; i < DpIconCount; ++i) {
+            const DpAtlasRect& r = rects[i];
+            for (int y = 0; y < r.height; ++y) {
+                for (int x = 0; x < r.width; ++x) {
+                    const size_t p = (static_cast<size_t>(r.y + y) * base.width + r.x + x) * bpp;
+                    for (int c = 0; c < bpp; ++c) {
+                        expected[p + c] = Coverage(i, x, y);
+                    }
+                }
+            }
+        }
+        Check(base.pixels == expected, "level 0 pixels match the glyphs");
+
+        // Niveaux de mip : tailles divisées par 2, moyenne 2x2 arrondie
+        Check(static_cast<int>(atlas.levels.size()) == maxLevels, "mip level count");
+        bool mipSizes = true;
+        bool mipPixels = true;
+        for (size_t level = 1; level < atlas.levels.size(); ++level) {
+            const DpAtlasMipLevel& src = atlas.levels[level - 1];
+            const DpAtlasMipLevel& dst = atlas.levels[level];
+            mipSizes = dst.width == std::max(1, base.width >> level)
+                    && dst.height == std::max(1, base.height >> level)
+                    && dst.pixels.size() == static_cast<size_t>(dst.width) * dst.height * bpp
+                    && mipSizes;
+            for (int y = 0; y < dst.height && mipPixels; ++y) {
+                for (int x = 0; x < dst.width; ++x) {
+                    for (int c = 0; c < bpp; ++c) {
+                        auto at = [&](int sx, int sy) {
+                            return src.pixels[(static_cast<size_t>(sy) * src.width + sx) * bpp + c];
+                        };
+                        const int sum = at(2 * x, 2 * y) + at(2 * x + 1, 2 * y)
+                                      + at(2 * x, 2 * y + 1) + at(2 * x + 1, 2 * y + 1);
+                        mipPixels = dst.pixels[(static_cast<size_t>(y) * dst.width + x) * bpp + c] == (sum + 2) / 4
+                                 && mipPixels;
+                    }
+                }
+            }
+        }
+        Check(mipSizes, "mip sizes halve");
+        Check(mipPixels, "mip pixels are the rounded 2x2 average");
+    }
+
+    void TestInvalidInput() {
+        DpIconAtlas atlas;
+        std::vector<DpGlyphBitmap> glyphs = SyntheticGlyphs();
+        glyphs.pop_back();
+        Check(!DpIconAtlas::Build(glyphs, DpAtlasFormat::Alpha8, 1, atlas), "missing glyph is rejected");
+
+        glyphs = SyntheticGlyphs();
+        glyphs[3].alpha.pop_back();
+        Check(!DpIconAtlas::Build(glyphs, DpAtlasFormat::Alpha8, 1, atlas), "truncated glyph is rejected");
+    }
+}
+
+int main() {
+    TestPacker();
+    TestBuild(DpAtlasFormat::RGBA8, "RGBA8");
+    TestBuild(DpAtlasFormat::Alpha8, "Alpha8");
+    TestInvalidInput();
+    return g_failures == 0 ? 0 : 1;
+}
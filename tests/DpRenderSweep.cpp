@@ -0,0 +1,184 @@
+#include "DpRenderSweep.h"
+#include "DpThemeLatency.h"
+#include <wx/bitmap.h>
+#include <wx/dcmemory.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/imagpng.h>
+#include <wx/log.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    constexpr int kColumns = 16;  // Icônes par ligne de planche
+}
+
+DpRenderSweep::DpRenderSweep(const DpRenderSweepOptions& options)
+    : m_options(options) {
+}
+
+wxString DpRenderSweep::GetSheetName(const wxString& themeName, DpThemeMode mode, int pixelSize, double scale) {
+    wxString theme = themeName;
+    theme.Replace(" ", "_");
+    return wxString::Format("%s-%s-%dpx-%d.png", theme,
+                            mode == DpThemeMode::Day ? "day" : "night",
+                            pixelSize, static_cast<int>(std::lround(scale * 100.0)));
+}
+
+wxImage DpRenderSweep::RenderSheet(const DpPalette& palette, int pixelSize, double scale,
+                                   const std::vector<DpIconStyle>& styles, uint64_t* iconCount) {
+    DpIconManager& icons = DpIconManager::Instance();
+
+    const int iconPixels = std::max(1, static_cast<int>(std::lround(pixelSize * scale)));
+    const int padding = std::max(1, static_cast<int>(std::lround(2 * scale)));
+    const int cell = iconPixels + 2 * padding;
+    const int iconRows = (DpIconCount + kColumns - 1) / kColumns;
+    const int swatchRows = (DpColorRoleCount + kColumns - 1) / kColumns;
+    const int rows = iconRows * static_cast<int>(styles.size()) + swatchRows;
+
+    wxBitmap sheet(kColumns * cell, rows * cell, 24);
+    wxMemoryDC dc(sheet);
+    dc.SetBackground(wxBrush(palette[DpColorRole::Background_1]));
+    dc.Clear();
+
+    // Nuancier : un carré par rôle, bordé de Border_1, sous les icônes
+    const int swatchRow = iconRows * static_cast<int>(styles.size());
+    dc.SetPen(wxPen(palette[DpColorRole::Border_1]));
+    for (int r = 0; r < DpColorRoleCount; ++r) {
+        dc.SetBrush(wxBrush(palette[static_cast<DpColorRole>(r)]));
+        dc.DrawRectangle((r % kColumns) * cell + padding, (swatchRow + r / kColumns) * cell + padding,
+                         iconPixels, iconPixels);
+    }
+    dc.SelectObject(wxNullBitmap);
+    wxImage image = sheet.ConvertToImage();
+
+    // Icônes de chaque style, dans la couleur de texte du thème, par le chemin public
+    // du plugin : masque de GetIconMask (caches mémoire et disque) teinté au dessin
+    const wxColour& text = palette[DpColorRole::TextPrimary];
+    int row = 0;
+    for (DpIconStyle style : styles) {
+        for (int i = 0; i < DpIconCount; ++i) {
+            const int x = (i % kColumns) * cell + padding;
+            const int y = (row + i / kColumns) * cell + padding;
+            icons.DrawIcon(image, x, y, static_cast<DpIcon>(i), iconPixels, text, nullptr, style);
+        }
+        row += iconRows;
+        if (iconCount) {
+            *iconCount += DpIconCount;
+        }
+    }
+    return image;
+}
+
+// Compare une planche à sa référence (ou la réécrit)
+DpRenderSheetResult DpRenderSweep::CheckGolden(const wxString& name, const wxImage& image) const {
+    DpRenderSheetResult result;
+    result.name = name;
+
+    wxFileName fn(m_options.goldenDir, name);
+    if (m_options.updateGoldens) {
+        if (!fn.DirExists() && !fn.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+            wxLogWarning("Unable to create golden directory: %s", fn.GetPath());
+        }
+        result.hasGolden = image.SaveFile(fn.GetFullPath(), wxBITMAP_TYPE_PNG);
+        result.matches = result.hasGolden;
+        return result;
+    }
+
+    wxImage golden;
+    if (!wxFileExists(fn.GetFullPath()) || !golden.LoadFile(fn.GetFullPath(), wxBITMAP_TYPE_PNG)) {
+        return result;
+    }
+    result.hasGolden = true;
+
+    if (golden.GetWidth() != image.GetWidth() || golden.GetHeight() != image.GetHeight()) {
+        result.differingPixels = static_cast<uint64_t>(image.GetWidth()) * image.GetHeight();
+        result.maxDelta = 255;
+        return result;
+    }
+
+    const unsigned char* a = image.GetData();
+    const unsigned char* b = golden.GetData();
+    const size_t pixels = static_cast<size_t>(image.GetWidth()) * image.GetHeight();
+    for (size_t i = 0; i < pixels; ++i) {
+        int delta = 0;
+        for (int c = 0; c < 3; ++c) {
+            delta = std::max(delta, std::abs(a[i * 3 + c] - b[i * 3 + c]));
+        }
+        result.maxDelta = std::max(result.maxDelta, delta);
+        if (delta > m_options.maxChannelDelta) {
+            ++result.differingPixels;
+        }
+    }
+    result.matches = (result.differingPixels == 0);
+    return result;
+}
+
+DpRenderSweepReport DpRenderSweep::Run() {
+    if (!wxImage::FindHandler(wxBITMAP_TYPE_PNG)) {
+        wxImage::AddHandler(new wxPNGHandler);
+    }
+
+    DpRenderSweepReport report;
+    const std::vector<DpThemeProfile> themes = DpThemeLibrary::GetAllThemes();
+    const DpThemeMode modes[] = {DpThemeMode::Day, DpThemeMode::Night};
+    const bool compare = !m_options.goldenDir.IsEmpty();
+
+    for (int iteration = 0; iteration < std::max(1, m_options.iterations); ++iteration) {
+        // Planches du premier balayage conservées pour la comparaison, hors chronométrage
+        std::vector<std::pair<wxString, wxImage>> sheets;
+        uint64_t iconCount = 0;
+
+        const int64_t begin = DpNowMicros();
+        for (const DpThemeProfile& theme : themes) {
+            for (DpThemeMode mode : modes) {
+                const DpPalette& palette = (mode == DpThemeMode::Day) ? theme.day : theme.night;
+                for (int pixelSize : m_options.pixelSizes) {
+                    for (double scale : m_options.dpiScales) {
+                        wxImage image = RenderSheet(palette, pixelSize, scale, m_options.styles, &iconCount);
+                        if (iteration == 0 && compare) {
+                            sheets.emplace_back(GetSheetName(theme.name, mode, pixelSize, scale), std::move(image));
+                        }
+                    }
+                }
+            }
+        }
+        report.sweepSeconds.push_back((DpNowMicros() - begin) / 1e6);
+        report.icons = iconCount;
+        report.sheets = static_cast<int>(themes.size() * 2 * m_options.pixelSizes.size() * m_options.dpiScales.size());
+
+        for (const auto& sheet : sheets) {
+            DpRenderSheetResult result = CheckGolden(sheet.first, sheet.second);
+            if (!result.hasGolden) {
+                ++report.missingGoldens;
+            } else if (!result.matches) {
+                ++report.mismatches;
+            }
+            report.results.push_back(std::move(result));
+        }
+    }
+    return report;
+}
+
+wxString DpRenderSweepReport::ToString() const {
+    wxString out;
+    if (!sweepSeconds.empty()) {
+        std::vector<double> sorted = sweepSeconds;
+        std::sort(sorted.begin(), sorted.end());
+        const double median = sorted[sorted.size() / 2];
+        out += wxString::Format("sheets=%d icons=%llu sweeps=%zu first=%.1fms median=%.1fms min=%.1fms (%.0f icons/s)\n",
+                                sheets, static_cast<unsigned long long>(icons), sweepSeconds.size(),
+                                sweepSeconds.front() * 1e3, median * 1e3, sorted.front() * 1e3,
+                                median > 0.0 ? icons / median : 0.0);
+    }
+    out += wxString::Format("compared=%zu mismatches=%d missingGoldens=%d\n",
+                            results.size(), mismatches, missingGoldens);
+    for (const DpRenderSheetResult& result : results) {
+        if (result.hasGolden && !result.matches) {
+            out += wxString::Format("  %s: %llu pixels differ (max delta %d)\n", result.name,
+                                    static_cast<unsigned long long>(result.differingPixels), result.maxDelta);
+        }
+    }
+    return out;
+}
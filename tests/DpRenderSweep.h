@@ -0,0 +1,81 @@
+#pragma once
+
+#include "DpIcons.h"
+#include "DpThemes.h"
+#include <wx/image.h>
+#include <wx/string.h>
+#include <vector>
+
+/**
+ * @brief Paramètres d'un balayage de rendu
+ */
+struct DpRenderSweepOptions {
+    std::vector<int> pixelSizes = {16, 24, 32};        // Tailles d'icônes (avant DPI)
+    std::vector<double> dpiScales = {1.0, 1.5, 2.0};   // Facteurs d'échelle simulés
+    std::vector<DpIconStyle> styles = {DpIconStyle::Solid, DpIconStyle::Regular};
+    int iterations = 5;           // Balayages chronométrés (le premier à froid) ; seul le premier est comparé
+    int maxChannelDelta = 0;      // Écart toléré par canal (0 = identique au pixel près)
+    wxString goldenDir;           // Images de référence (vide = pas de comparaison)
+    bool updateGoldens = false;   // Réécrit les références au lieu de comparer
+};
+
+/**
+ * @brief Comparaison d'une planche avec son image de référence
+ */
+struct DpRenderSheetResult {
+    wxString name;
+    bool hasGolden = false;
+    bool matches = false;
+    uint64_t differingPixels = 0;  // Pixels dont un canal dépasse maxChannelDelta
+    int maxDelta = 0;              // Plus grand écart observé sur un canal
+};
+
+/**
+ * @brief Résultat d'un balayage de rendu
+ */
+struct DpRenderSweepReport {
+    int sheets = 0;                    // Planches par balayage
+    uint64_t icons = 0;                // Icônes dessinées par balayage
+    std::vector<double> sweepSeconds;  // Durée de chaque balayage (le premier remplit les caches)
+    std::vector<DpRenderSheetResult> results;
+    int mismatches = 0;
+    int missingGoldens = 0;
+
+    bool Passed() const { return mismatches == 0; }
+    wxString ToString() const;
+};
+
+/**
+ * @brief Balayage de rendu hors écran de toutes les icônes et de tous les thèmes
+ *
+ * Pour chaque thème de DpThemeLibrary, chaque mode, taille et échelle DPI,
+ * dessine une planche (toutes les DpIcon de chaque style, puis un nuancier
+ * des DpColorRole) dans une image en mémoire, en passant uniquement par les
+ * API publiques. Les icônes sont dessinées par DpIconManager::DrawIcon, comme
+ * dans le plugin : le premier balayage remplit les caches de masques (mémoire
+ * et disque), les suivants mesurent le dessin depuis ces caches. Compare les pixels du premier balayage aux images
+ * de référence PNG, pour vérifier qu'une optimisation du rendu ou des caches
+ * d'icônes ne change pas le résultat.
+ *
+ * Le DpIconManager doit être initialisé par l'hôte (voir DpRenderSweepTool.cpp).
+ * Sous Linux sans écran, lancer l'outil dans un serveur X virtuel (Xvfb).
+ */
+class DpRenderSweep {
+public:
+    explicit DpRenderSweep(const DpRenderSweepOptions& options = DpRenderSweepOptions());
+
+    // Balayages chronométrés, puis comparaison (ou mise à jour) des références
+    DpRenderSweepReport Run();
+
+    // Planche d'un thème pour un mode, une taille et une échelle
+    static wxImage RenderSheet(const DpPalette& palette, int pixelSize, double scale,
+                               const std::vector<DpIconStyle>& styles, uint64_t* iconCount = nullptr);
+
+    // Nom de fichier de référence, ex. "Dark_capsule-night-24px-150.png"
+    static wxString GetSheetName(const wxString& themeName, DpThemeMode mode, int pixelSize, double scale);
+
+private:
+    DpRenderSweepOptions m_options;
+
+    DpRenderSheetResult CheckGolden(const wxString& name, const wxImage& image) const;
+};
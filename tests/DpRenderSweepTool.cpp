@@ -0,0 +1,60 @@
+/**
+ * Balayage de rendu en ligne de commande (voir DpRenderSweep).
+ *
+ *   dp_render_sweep --data <dossier du plugin> [--golden <dossier>] [--update] [--iterations N] [--delta N]
+ *
+ * Le dossier du plugin contient data/resources (fichiers OTF). Cible dp_render_sweep de
+ * tests/CMakeLists.txt (wxWidgets et wxJSON requis) ; sans écran, lancer sous Xvfb.
+ * Code de retour non nul si une planche diffère de sa référence.
+ */
+#include "DpRenderSweep.h"
+#include <wx/app.h>
+#include <cstdio>
+
+class DpRenderSweepApp : public wxApp {
+public:
+    bool OnInit() override { return true; }
+
+    int OnRun() override {
+        DpRenderSweepOptions options;
+        wxString dataPath;
+        for (int i = 1; i < argc; ++i) {
+            const wxString arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--data" && hasValue) {
+                dataPath = argv[++i];
+            } else if (arg == "--golden" && hasValue) {
+                options.goldenDir = argv[++i];
+            } else if (arg == "--update") {
+                options.updateGoldens = true;
+            } else if (arg == "--iterations" && hasValue) {
+                options.iterations = wxAtoi(argv[++i]);
+            } else if (arg == "--delta" && hasValue) {
+                options.maxChannelDelta = wxAtoi(argv[++i]);
+            } else {
+                dataPath.Clear();
+                break;
+            }
+        }
+        if (dataPath.IsEmpty()) {
+            std::fprintf(stderr, "usage: dp_render_sweep --data <dir> [--golden <dir>] [--update] "
+                                 "[--iterations N] [--delta N]\n");
+            return 2;
+        }
+
+        DpIconCallbacks callbacks;
+        callbacks.getDataPath = [dataPath]() { return dataPath; };
+        DpIconManager::Instance().Init(callbacks);
+
+        DpRenderSweep sweep(options);
+        const DpRenderSweepReport report = sweep.Run();
+        std::fputs(report.ToString().utf8_str(), stdout);
+        return report.Passed() ? 0 : 1;
+    }
+};
+
+wxIMPLEMENT_APP_NO_MAIN(DpRenderSweepApp);
+
+int main(int argc, char** argv) {
+    return wxEntry(argc, argv);
+}
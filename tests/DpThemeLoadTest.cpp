@@ -0,0 +1,204 @@
+#include "DpThemeLoadTest.h"
+#include "DpAnimationClock.h"
+#include "DpIcons.h"
+#include "DpRepaintScheduler.h"
+#include "DpThemeClient.h"
+#include <wx/fileconf.h>
+#include <wx/jsonreader.h>
+#include <wx/jsonval.h>
+#include <wx/jsonwriter.h>
+#include <wx/sstream.h>
+#include <wx/textfile.h>
+#include <chrono>
+#include <thread>
+
+// Client instanciable (le constructeur de DpThemeClient est protégé) ; les services
+// du processus ne suivent que DpThemeClient::Instance, sauf s'ils y sont abonnés ici
+class DpThemeLoadHarness::Client : public DpThemeClient {
+public:
+    explicit Client(bool sharedServices) {
+        if (sharedServices) {
+            DpRepaintScheduler::Instance().Attach(*this);
+            DpAnimationClock::Instance().Attach(*this);
+            DpIconManager::Instance().Attach(*this);
+        }
+    }
+    ~Client() override = default;
+};
+
+// Configuration en mémoire qui compte les écritures disque demandées
+class DpThemeLoadHarness::CountingConfig : public wxFileConfig {
+public:
+    explicit CountingConfig(wxInputStream& input) : wxFileConfig(input) {}
+
+    bool Flush(bool WXUNUSED(currentOnly) = false) override {
+        ++m_flushes;
+        return true;
+    }
+
+    uint64_t GetFlushCount() const { return m_flushes; }
+
+private:
+    uint64_t m_flushes = 0;
+};
+
+DpThemeLoadHarness::DpThemeLoadHarness(const DpThemeLoadOptions& options)
+    : m_options(options) {
+}
+
+DpThemeLoadHarness::~DpThemeLoadHarness() = default;
+
+void DpThemeLoadHarness::GenerateSyntheticStream() {
+    m_stream.clear();
+    const std::vector<wxString> themes = DpThemeLibrary::GetThemeNames();
+    if (themes.empty()) return;
+
+    wxJSONWriter writer(wxJSONWRITER_NONE);
+    for (int i = 0; i < m_options.messageCount; ++i) {
+        wxJSONValue message;
+        message["type"] = "theme_changed";
+        message["theme"] = themes[(i / 2) % themes.size()];
+        message["mode"] = (i % 2) ? "night" : "day";
+
+        wxString body;
+        writer.Write(message, body);
+        m_stream.push_back(body);
+    }
+}
+
+bool DpThemeLoadHarness::LoadRecording(const wxString& path) {
+    wxTextFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+
+    m_stream.clear();
+    for (size_t i = 0; i < file.GetLineCount(); ++i) {
+        wxString line = file[i];
+        if (!line.Trim(true).Trim(false).IsEmpty()) {
+            m_stream.push_back(line);
+        }
+    }
+    return !m_stream.empty();
+}
+
+void DpThemeLoadHarness::CreateClients() {
+    m_clients.clear();
+    m_notifications = 0;
+    m_sentMessages = 0;
+
+    const wxString emptyConfig;
+    wxStringInputStream input(emptyConfig);
+    m_config = std::make_unique<CountingConfig>(input);
+
+    DpThemeClientCallbacks callbacks;
+    callbacks.sendMessage = [this](const wxString&, const wxString&) { ++m_sentMessages; };
+    callbacks.getConfig = [this]() -> wxFileConfig* { return m_config.get(); };
+
+    for (int i = 0; i < m_options.clientCount; ++i) {
+        auto client = std::make_unique<Client>(m_options.sharedServices);
+        client->RegisterCallback([this]() { ++m_notifications; });
+        client->Init(wxString::Format("LoadClient%d", i), callbacks);
+        m_clients.push_back(std::move(client));
+    }
+}
+
+// Horodate le message au moment de sa diffusion
+wxString DpThemeLoadHarness::StampMessage(const wxString& body, long changeId) const {
+    wxJSONReader reader;
+    wxJSONValue message;
+    if (reader.Parse(body, &message) != 0) {
+        return body;
+    }
+
+    DpStampThemeMessage(message, changeId);
+
+    wxJSONWriter writer(wxJSONWRITER_NONE);
+    wxString stamped;
+    writer.Write(message, stamped);
+    return stamped;
+}
+
+DpThemeLoadReport DpThemeLoadHarness::Run() {
+    if (m_stream.empty()) {
+        GenerateSyntheticStream();
+    }
+    CreateClients();
+
+    DpThemeLoadReport report;
+    report.clientCount = static_cast<int>(m_clients.size());
+    report.sharedServices = m_options.sharedServices;
+
+    // Réponse du propriétaire du thème aux requêtes émises par Init
+    const wxString current = "{\"type\":\"theme_current\",\"theme\":\"Ocean\",\"mode\":\"day\"}";
+    for (auto& client : m_clients) {
+        client->HandleThemeMessage(current);
+        client->ResetLatencyStats();
+    }
+    const uint64_t flushesBefore = m_config->GetFlushCount();
+    const uint64_t notificationsBefore = m_notifications;
+
+    using Clock = std::chrono::steady_clock;
+    const auto interval = m_options.messagesPerSecond > 0.0
+        ? std::chrono::duration<double>(1.0 / m_options.messagesPerSecond)
+        : std::chrono::duration<double>(0.0);
+    const auto start = Clock::now();
+
+    for (size_t i = 0; i < m_stream.size(); ++i) {
+        if (interval.count() > 0.0) {
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(i)));
+        }
+
+        // Diffusion à tous les plugins, comme SetPluginMessage d'OpenCPN
+        const wxString body = m_options.stampMessages ? StampMessage(m_stream[i], static_cast<long>(i)) : m_stream[i];
+        for (auto& client : m_clients) {
+            const int64_t begin = DpNowMicros();
+            client->HandleThemeMessage(body);
+            report.handling.Record(DpNowMicros() - begin);
+        }
+    }
+
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    report.messages = m_stream.size();
+    report.deliveries = report.messages * m_clients.size();
+    report.deliveriesPerSecond = report.seconds > 0.0 ? report.deliveries / report.seconds : 0.0;
+    report.notifications = m_notifications - notificationsBefore;
+    report.configFlushes = m_config->GetFlushCount() - flushesBefore;
+    report.sentMessages = m_sentMessages;
+
+    for (const auto& client : m_clients) {
+        const DpThemeLatencyStats& stats = client->GetLatencyStats();
+        report.latency.delivery.Merge(stats.delivery);
+        report.latency.apply.Merge(stats.apply);
+        report.latency.notify.Merge(stats.notify);
+        report.latency.endToEnd.Merge(stats.endToEnd);
+    }
+    return report;
+}
+
+wxString DpThemeLoadReport::ToString() const {
+    auto line = [](const char* label, const DpLatencyHistogram& h) {
+        return wxString::Format("%-10s n=%llu p50=%lldus p99=%lldus max=%lldus\n", label,
+                                static_cast<unsigned long long>(h.GetCount()),
+                                static_cast<long long>(h.GetPercentileMicros(50)),
+                                static_cast<long long>(h.GetPercentileMicros(99)),
+                                static_cast<long long>(h.GetMax()));
+    };
+
+    wxString out;
+    out += wxString::Format("clients=%d%s messages=%llu deliveries=%llu in %.3fs (%.0f/s)\n",
+                            clientCount, sharedServices ? " (shared services)" : "",
+                            static_cast<unsigned long long>(messages),
+                            static_cast<unsigned long long>(deliveries),
+                            seconds, deliveriesPerSecond);
+    out += wxString::Format("notifications=%llu configFlushes=%llu sentMessages=%llu\n",
+                            static_cast<unsigned long long>(notifications),
+                            static_cast<unsigned long long>(configFlushes),
+                            static_cast<unsigned long long>(sentMessages));
+    out += line("handling", handling);
+    out += line("delivery", latency.delivery);
+    out += line("apply", latency.apply);
+    out += line("notify", latency.notify);
+    out += line("end2end", latency.endToEnd);
+    return out;
+}
\ No newline at end of file
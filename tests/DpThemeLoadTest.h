@@ -0,0 +1,86 @@
+#pragma once
+
+#include "DpThemeLatency.h"
+#include <wx/string.h>
+#include <memory>
+#include <vector>
+
+class DpThemeClient;
+
+/**
+ * @brief Paramètres d'une charge simulée
+ */
+struct DpThemeLoadOptions {
+    int clientCount = 20;       // Nombre de plugins clients simulés
+    int messageCount = 1000;    // Messages synthétiques (ignoré si un enregistrement est chargé)
+    double messagesPerSecond = 0.0;  // 0 = aussi vite que possible
+    bool stampMessages = true;  // Ajoute change_id / sent_us (traçage des latences)
+    // true : chaque client prévient aussi les singletons du processus (repeint, horloge
+    // d'animation, cache RGB565). Tous les clients se disputent alors un seul état, ce qui
+    // n'arrive pas dans OpenCPN où chaque plugin a sa propre copie de la bibliothèque.
+    bool sharedServices = false;
+};
+
+/**
+ * @brief Résultat d'une charge simulée
+ */
+struct DpThemeLoadReport {
+    int clientCount = 0;
+    bool sharedServices = false;    // Singletons du processus exercés par tous les clients
+    uint64_t messages = 0;          // Messages rejoués
+    uint64_t deliveries = 0;        // messages x clients
+    double seconds = 0.0;
+    double deliveriesPerSecond = 0.0;
+    uint64_t notifications = 0;     // Callbacks de changement appelés
+    uint64_t configFlushes = 0;     // wxFileConfig::Flush
+    uint64_t sentMessages = 0;      // Messages émis par les clients (sendMessage)
+    DpLatencyHistogram handling;    // Durée de HandleThemeMessage, par livraison
+    DpThemeLatencyStats latency;    // Latences cumulées de tous les clients
+
+    wxString ToString() const;
+};
+
+/**
+ * @brief Banc de charge du protocole de thème, sans OpenCPN
+ *
+ * Remplace les callbacks sendMessage/getConfig d'OpenCPN, crée de nombreux
+ * DpThemeClient et leur diffuse des flux theme_current/theme_changed
+ * synthétiques ou enregistrés (un message JSON par ligne).
+ *
+ * Ce qui est mesuré : par client, l'analyse du message, l'application du thème (palette
+ * résolue, configuration) et les notifications, chaque client ayant son propre état
+ * (la wxFileConfig est commune, comme le fichier de configuration unique d'OpenCPN).
+ * Seules les données de DpThemeLibrary, en lecture seule, sont partagées (comme le
+ * serait le contenu identique des copies de la bibliothèque dans chaque plugin). Les
+ * services du processus ne sont exercés qu'avec sharedServices, par tous les clients.
+ */
+class DpThemeLoadHarness {
+public:
+    explicit DpThemeLoadHarness(const DpThemeLoadOptions& options = DpThemeLoadOptions());
+    ~DpThemeLoadHarness();
+
+    // Flux synthétique : alterne thèmes et modes jour/nuit
+    void GenerateSyntheticStream();
+
+    // Flux enregistré : un message JSON par ligne
+    bool LoadRecording(const wxString& path);
+
+    size_t GetStreamSize() const { return m_stream.size(); }
+
+    // Crée les clients et rejoue le flux
+    DpThemeLoadReport Run();
+
+private:
+    class Client;
+    class CountingConfig;
+
+    DpThemeLoadOptions m_options;
+    std::vector<wxString> m_stream;
+    std::vector<std::unique_ptr<Client>> m_clients;
+    std::unique_ptr<CountingConfig> m_config;
+    uint64_t m_notifications = 0;
+    uint64_t m_sentMessages = 0;
+
+    void CreateClients();
+    wxString StampMessage(const wxString& body, long changeId) const;
+};
\ No newline at end of file
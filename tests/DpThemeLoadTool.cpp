@@ -0,0 +1,53 @@
+/**
+ * Banc de charge du protocole de thème en ligne de commande (voir DpThemeLoadHarness).
+ *
+ *   dp_theme_load [--clients N] [--messages N] [--rate N] [--no-stamp] [--shared] [enregistrement.jsonl]
+ *
+ * Cible dp_theme_load de tests/CMakeLists.txt (wxWidgets et wxJSON requis).
+ */
+#include "DpThemeLoadTest.h"
+#include <wx/init.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, char** argv) {
+    wxInitializer initializer;
+    if (!initializer.IsOk()) {
+        std::fprintf(stderr, "wxWidgets initialization failed\n");
+        return 2;
+    }
+
+    DpThemeLoadOptions options;
+    wxString recording;
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--clients") == 0 && hasValue) {
+            options.clientCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--messages") == 0 && hasValue) {
+            options.messageCount = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rate") == 0 && hasValue) {
+            options.messagesPerSecond = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--no-stamp") == 0) {
+            options.stampMessages = false;
+        } else if (std::strcmp(argv[i], "--shared") == 0) {
+            options.sharedServices = true;
+        } else if (argv[i][0] != '-') {
+            recording = wxString::FromUTF8(argv[i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--clients N] [--messages N] [--rate N] [--no-stamp] [--shared] [recording]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    DpThemeLoadHarness harness(options);
+    if (!recording.IsEmpty() && !harness.LoadRecording(recording)) {
+        std::fprintf(stderr, "Unable to read recording: %s\n", static_cast<const char*>(recording.utf8_str()));
+        return 1;
+    }
+
+    const DpThemeLoadReport report = harness.Run();
+    std::fputs(report.ToString().utf8_str(), stdout);
+    return 0;
+}